@@ -0,0 +1,196 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "SSVBloodshed/CESystem/CES.hpp"
+
+// Headless version of the ssvces stress scenario in main.cpp, plus a few variants
+// Prints per-phase timings as JSON, to stdout or to the file passed as first argument
+
+using namespace ssvces;
+using FT = ssvu::FT;
+
+struct CPosition : Component		{ float x, y; CPosition(float mX, float mY) : x{mX}, y{mY} { } };
+struct CVelocity : Component		{ float x, y; CVelocity(float mX, float mY) : x{mX}, y{mY} { } };
+struct CAcceleration : Component	{ float x, y; CAcceleration(float mX, float mY) : x{mX}, y{mY} { } };
+struct CLife : Component			{ float life; CLife(float mLife) : life{mLife} { } };
+struct CColor : Component			{ unsigned int rgba{0}; };
+struct CColorInhibitor : Component	{ float life; CColorInhibitor(float mLife) : life{mLife} { } };
+
+struct SMovement : System<SMovement, Req<CPosition, CVelocity, CAcceleration>, Not<>, Read<CAcceleration>>
+{
+	inline void update(FT mFT) { processAll(mFT); }
+	inline void process(Entity&, CPosition& cPosition, CVelocity& cVelocity, CAcceleration& cAcceleration, FT mFT)
+	{
+		cVelocity.x += cAcceleration.x * mFT;
+		cVelocity.y += cAcceleration.y * mFT;
+		cPosition.x += cVelocity.x * mFT;
+		cPosition.y += cVelocity.y * mFT;
+	}
+};
+
+struct SDeath : System<SDeath, Req<CLife>>
+{
+	inline void update(FT mFT) { processAll(mFT); }
+	inline void process(Entity& entity, CLife& cLife, FT mFT)
+	{
+		cLife.life -= mFT;
+		if(cLife.life < 0) entity.destroy();
+	}
+};
+
+struct SNonColorInhibitor : System<SNonColorInhibitor, Req<CColor>, Not<CColorInhibitor>>
+{
+	inline void update() { processAll(); }
+	inline void process(Entity&, CColor& cColor) { cColor.rgba = 0xFF0000FF; }
+};
+
+struct SColorInhibitor : System<SColorInhibitor, Req<CColor, CColorInhibitor>>
+{
+	inline void update(FT mFT) { processAll(mFT); }
+	inline void process(Entity& entity, CColor& cColor, CColorInhibitor& cColorInhibitor, FT mFT)
+	{
+		cColor.rgba = 0x0000FFFF;
+		cColorInhibitor.life -= mFT;
+		if(cColorInhibitor.life < 0) entity.removeComponent<CColorInhibitor>();
+	}
+};
+
+struct Phases { double create{0}, refresh{0}, process{0}, destroy{0}; };
+
+template<typename TF> inline void timed(double& mMs, TF mFn)
+{
+	auto start(std::chrono::high_resolution_clock::now());
+	mFn();
+	mMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+class Bench
+{
+	public:
+		Manager manager;
+		SMovement sMovement;
+		SDeath sDeath;
+		SNonColorInhibitor sNonColorInhibitor;
+		SColorInhibitor sColorInhibitor;
+		Phases phases;
+		std::size_t frames{0}, peakEntities{0};
+
+		inline Bench()
+		{
+			manager.registerSystem(sMovement);
+			manager.registerSystem(sDeath);
+			manager.registerSystem(sNonColorInhibitor);
+			manager.registerSystem(sColorInhibitor);
+		}
+
+		inline void create(std::size_t mCount, float mLifeMin, float mLifeMax, bool mColored = false, Group mGroup = 0)
+		{
+			timed(phases.create, [&]
+			{
+				for(auto i(0u); i < mCount; ++i)
+				{
+					auto e(manager.createEntity());
+					e.createComponent<CPosition>(ssvu::getRndR(412.f, 612.f), ssvu::getRndR(284.f, 484.f));
+					e.createComponent<CVelocity>(ssvu::getRndR(-1.f, 1.f), ssvu::getRndR(-1.f, 1.f));
+					e.createComponent<CAcceleration>(ssvu::getRndR(-0.5f, 0.5f), ssvu::getRndR(-0.5f, 0.5f));
+					e.createComponent<CLife>(ssvu::getRndR(mLifeMin, mLifeMax));
+					if(mColored) { e.createComponent<CColor>(); e.createComponent<CColorInhibitor>(ssvu::getRndR(5.f, 85.f)); }
+					e.addGroups(mGroup);
+				}
+			});
+		}
+		inline void frame(FT mFT)
+		{
+			timed(phases.refresh, [&]{ manager.refresh(); });
+			timed(phases.process, [&]
+			{
+				sMovement.update(mFT);
+				sDeath.update(mFT);
+				sNonColorInhibitor.update();
+				sColorInhibitor.update(mFT);
+			});
+
+			peakEntities = std::max(peakEntities, manager.getEntityCount());
+			++frames;
+		}
+		inline void destroyGroup(Group mGroup)
+		{
+			timed(phases.destroy, [&]{ for(auto& e : manager.getEntities(mGroup)) e->destroy(); });
+		}
+		inline void destroyAll()
+		{
+			timed(phases.destroy, [&]{ for(auto& e : manager.getEntities()) e->destroy(); manager.refresh(); });
+		}
+};
+
+// The commented-out benchmark from main.cpp: bursts of 20000 entities, first short-lived then long-lived
+inline void runBaseline(Bench& b)
+{
+	for(auto life : {1.f, 25.f})
+		for(int k{0}; k < 5; ++k)
+		{
+			b.create(20000, life, life);
+			for(int f{0}; f < 3; ++f) b.frame(5);
+		}
+	b.destroyAll();
+}
+
+// Constant spawning and dying: 2000 new entities per frame, each living 2 to 10 frames
+inline void runChurn(Bench& b)
+{
+	for(int f{0}; f < 200; ++f) { b.create(2000, 2.f, 10.f, true); b.frame(1); }
+	b.destroyAll();
+}
+
+// Stable population: 100000 immortal entities processed for 100 frames
+inline void runIteration(Bench& b)
+{
+	b.create(100000, 1e9f, 1e9f, true);
+	for(int f{0}; f < 100; ++f) b.frame(1);
+	b.destroyAll();
+}
+
+// Group traffic: entities spread in 16 groups, one whole group destroyed and respawned every frame
+inline void runGroups(Bench& b)
+{
+	constexpr Group groupCount{16};
+	for(auto g(0u); g < groupCount; ++g) b.create(4000, 1e9f, 1e9f, false, g);
+	for(int f{0}; f < 100; ++f)
+	{
+		auto g(Group(f % groupCount));
+		b.destroyGroup(g);
+		b.frame(1);
+		b.create(4000, 1e9f, 1e9f, false, g);
+	}
+	b.destroyAll();
+}
+
+template<typename TF> inline void runAndAppendJson(std::ostringstream& mOut, const std::string& mName, TF mFn, bool mLast)
+{
+	Bench b; mFn(b);
+	const auto& p(b.phases);
+	mOut << "\t\t{\"name\": \"" << mName << "\", \"frames\": " << b.frames << ", \"peak_entities\": " << b.peakEntities
+		<< ", \"create_ms\": " << p.create << ", \"refresh_ms\": " << p.refresh << ", \"process_ms\": " << p.process
+		<< ", \"destroy_ms\": " << p.destroy << ", \"total_ms\": " << p.create + p.refresh + p.process + p.destroy << "}" << (mLast ? "\n" : ",\n");
+}
+
+int main(int argc, char* argv[])
+{
+	std::ostringstream out;
+	out << "{\n\t\"benchmarks\":\n\t[\n";
+	runAndAppendJson(out, "baseline", runBaseline, false);
+	runAndAppendJson(out, "churn", runChurn, false);
+	runAndAppendJson(out, "iteration", runIteration, false);
+	runAndAppendJson(out, "groups", runGroups, true);
+	out << "\t]\n}\n";
+
+	if(argc > 1) std::ofstream{argv[1]} << out.str();
+	else std::cout << out.str();
+
+	return 0;
+}
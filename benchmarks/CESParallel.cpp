@@ -0,0 +1,78 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include <chrono>
+#include <iostream>
+#include "SSVBloodshed/CESystem/CES.hpp"
+
+using namespace ssvces;
+using FT = ssvu::FT;
+
+struct CPosition : Component		{ float x, y; CPosition(float mX, float mY) : x{mX}, y{mY} { } };
+struct CVelocity : Component		{ float x, y; CVelocity(float mX, float mY) : x{mX}, y{mY} { } };
+struct CAcceleration : Component	{ float x, y; CAcceleration(float mX, float mY) : x{mX}, y{mY} { } };
+
+struct SMovement : System<SMovement, Req<CPosition, CVelocity, CAcceleration>>
+{
+	inline void update(FT mFT) { processAll(mFT); }
+	inline void updateParallel(ThreadPool& mPool, FT mFT) { processAllParallel(mPool, mFT); }
+	inline void setForceParallel(bool mValue) { setMinParallelEntities(mValue ? 0 : minParallelEntities); }
+	inline void process(Entity&, CPosition& cPosition, CVelocity& cVelocity, CAcceleration& cAcceleration, FT mFT)
+	{
+		cVelocity.x += cAcceleration.x * mFT;
+		cVelocity.y += cAcceleration.y * mFT;
+		cPosition.x += cVelocity.x * mFT;
+		cPosition.y += cVelocity.y * mFT;
+	}
+};
+
+template<typename TF> inline double getMsPerFrame(std::size_t mFrames, TF mFn)
+{
+	auto start(std::chrono::high_resolution_clock::now());
+	for(auto i(0u); i < mFrames; ++i) mFn();
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / mFrames;
+}
+
+int main()
+{
+	constexpr std::size_t frames{50};
+	ThreadPool pool;
+
+	std::size_t breakEven{0};
+
+	std::cout << "ssvces processAll vs processAllParallel (" << pool.getThreadCount() << " workers + caller, " << frames << " frames)\n";
+	std::cout << "entities\tserial ms\tforced parallel ms\tspeedup\tprocessAllParallel ms\n";
+
+	for(auto count : {1000u, 4000u, 16000u, 64000u, 100000u, 1000000u})
+	{
+		Manager manager;
+		SMovement sMovement;
+		manager.registerSystem(sMovement);
+
+		for(auto i(0u); i < count; ++i)
+		{
+			auto e(manager.createEntity());
+			e.createComponent<CPosition>(ssvu::getRndR(-100.f, 100.f), ssvu::getRndR(-100.f, 100.f));
+			e.createComponent<CVelocity>(ssvu::getRndR(-1.f, 1.f), ssvu::getRndR(-1.f, 1.f));
+			e.createComponent<CAcceleration>(ssvu::getRndR(-1.f, 1.f), ssvu::getRndR(-1.f, 1.f));
+		}
+		manager.refresh();
+
+		auto serial(getMsPerFrame(frames, [&]{ sMovement.update(0.01f); }));
+		sMovement.setForceParallel(true);
+		auto parallel(getMsPerFrame(frames, [&]{ sMovement.updateParallel(pool, 0.01f); }));
+		sMovement.setForceParallel(false);
+		auto defaulted(getMsPerFrame(frames, [&]{ sMovement.updateParallel(pool, 0.01f); }));
+
+		if(parallel >= serial) breakEven = 0; else if(breakEven == 0) breakEven = count;
+		std::cout << count << "\t\t" << serial << "\t\t" << parallel << "\t\t" << serial / parallel << "x\t" << defaulted << "\n";
+	}
+
+	// Smallest measured count from which forced parallel stays faster than serial, compare with minParallelEntities
+	std::cout << "\nbreak-even: ";
+	if(breakEven == 0) std::cout << "none measured"; else std::cout << breakEven << " entities";
+	std::cout << " (minParallelEntities = " << minParallelEntities << ")\n";
+
+	return 0;
+}
@@ -7,8 +7,12 @@
 
 #include "SSVBloodshed/CESystem/Common.hpp"
 #include "SSVBloodshed/CESystem/IdPool.hpp"
+#include "SSVBloodshed/CESystem/ComponentPool.hpp"
+#include "SSVBloodshed/CESystem/ThreadPool.hpp"
+#include "SSVBloodshed/CESystem/CommandBuffer.hpp"
 #include "SSVBloodshed/CESystem/SystemBase.hpp"
 #include "SSVBloodshed/CESystem/System.hpp"
+#include "SSVBloodshed/CESystem/Scheduler.hpp"
 #include "SSVBloodshed/CESystem/Entity.hpp"
 #include "SSVBloodshed/CESystem/EntityHandle.hpp"
 #include "SSVBloodshed/CESystem/Manager.hpp"
@@ -0,0 +1,52 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_CESYSTEM_COMMANDBUFFER
+#define SSVOB_CESYSTEM_COMMANDBUFFER
+
+#include <functional>
+#include "SSVBloodshed/CESystem/Common.hpp"
+
+namespace ssvces
+{
+	class Entity;
+
+	namespace Internal
+	{
+		class CommandBuffer
+		{
+			// CommandBuffer records structural changes requested while systems are processing
+			// Every thread gets its own buffer, the Manager applies all of them in order on refresh
+
+			public:
+				enum class Type : int { Destroy, Remove, Deferred };
+				struct Command { Type type; Entity* entity; std::size_t idx; }; // `idx` is a TypeIdIdx for Remove or an index in `deferred` otherwise
+
+			private:
+				std::vector<Command> commands;
+				std::vector<std::function<void()>> deferred; // Component additions and entity creations need their arguments
+
+			public:
+				inline void destroy(Entity& mEntity)							{ commands.push_back({Type::Destroy, &mEntity, 0}); }
+				inline void remove(Entity& mEntity, TypeIdIdx mTypeIdIdx)		{ commands.push_back({Type::Remove, &mEntity, mTypeIdIdx}); }
+				template<typename TF> inline void defer(TF&& mFn)				{ commands.push_back({Type::Deferred, nullptr, deferred.size()}); deferred.emplace_back(std::forward<TF>(mFn)); }
+
+				template<typename TDestroy, typename TRemove> inline void apply(TDestroy mFnDestroy, TRemove mFnRemove)
+				{
+					for(const auto& c : commands)
+					{
+						if(c.type == Type::Destroy) mFnDestroy(*c.entity);
+						else if(c.type == Type::Remove) mFnRemove(*c.entity, c.idx);
+						else deferred[c.idx]();
+					}
+
+					commands.clear(); deferred.clear();
+				}
+
+				inline bool isEmpty() const noexcept { return commands.empty(); }
+		};
+	}
+}
+
+#endif
@@ -13,6 +13,11 @@
 #include <cassert>
 #include <unordered_map>
 #include <bitset>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <memory>
 #include <SSVUtils/SSVUtils.hpp>
 
 namespace ssvces
@@ -22,11 +27,19 @@ namespace ssvces
 	static constexpr std::size_t maxEntities{1000000};
 	static constexpr std::size_t maxComponents{32};
 	static constexpr std::size_t maxGroups{32};
+	static constexpr std::size_t componentChunkSize{1024};
+	static constexpr std::size_t minParallelChunkSize{1024};
+
+	// Below this many entities `processAllParallel` runs serially: a batch costs ~20-25us to dispatch and wait for,
+	// while a light `process` costs ~2-6ns per entity, so smaller systems lose more than they gain (benchmarks/CESParallel.cpp prints the break-even)
+	static constexpr std::size_t minParallelEntities{16384};
 
 	using EntityId = std::size_t;
 	using EntityIdCtr = std::uint8_t;
 	struct EntityStat { EntityId id; EntityIdCtr ctr; };
 
+	using ComponentIdx = std::size_t;
+
 	using TypeIdIdx = std::size_t;
 	using TypeIdsBitset = std::bitset<maxComponents>;
 
@@ -39,21 +52,74 @@ namespace ssvces
 	{
 		class SystemBase;
 
-		// Returns the next unique bit index for a type
-		inline TypeIdIdx getNextTypeIdBitIdx() noexcept { static TypeIdIdx lastIdx{0}; return lastIdx++; }
+		// Marks an entity id that has no tuple in a system
+		static constexpr std::size_t nullSlot{std::numeric_limits<std::size_t>::max()};
+
+		// Returns a unique id for every Manager instance, never reused
+		inline std::size_t getNextManagerUid() noexcept { static std::atomic<std::size_t> lastUid{0}; return ++lastUid; }
+
+		// Bit indices in use: the ComponentList takes `[0, listSize)`, runtime types take `[maxComponents - runtimeCount, maxComponents)`
+		struct TypeIdRanges { std::mutex mutex; const void* list{nullptr}; TypeIdIdx listSize{0}, runtimeCount{0}; };
+		inline TypeIdRanges& getTypeIdRanges() noexcept { static TypeIdRanges result; return result; }
+
+		// Returns the next unique bit index for a type registered at runtime
+		// Runtime indices are handed out from the top, throws if the next one would reach the ComponentList's indices
+		inline TypeIdIdx getNextTypeIdBitIdx()
+		{
+			auto& r(getTypeIdRanges());
+			std::lock_guard<std::mutex> lock{r.mutex};
+			if(r.listSize + r.runtimeCount >= maxComponents) throw std::runtime_error("ssvces: too many Component types, runtime indices would overlap the ComponentList");
+			return maxComponents - 1 - r.runtimeCount++;
+		}
+
+		// Claims the low indices for the ComponentList identified by `mList`, throws if another list already claimed them
+		// or if runtime indices were already handed out in that range
+		inline void claimComponentList(const void* mList, TypeIdIdx mSize)
+		{
+			auto& r(getTypeIdRanges());
+			std::lock_guard<std::mutex> lock{r.mutex};
+			if(r.list == mList) return;
+			if(r.list != nullptr) throw std::runtime_error("ssvces: only one ComponentList can be used");
+			if(mSize + r.runtimeCount > maxComponents) throw std::runtime_error("ssvces: too many Component types, ComponentList would overlap runtime indices");
+			r.list = mList; r.listSize = mSize;
+		}
+
+		template<typename> struct VoidT { using Type = void; };
+
+		template<typename T, typename... TArgs> struct IndexOf;
+		template<typename T, typename... TArgs> struct IndexOf<T, T, TArgs...> : std::integral_constant<TypeIdIdx, 0> { };
+		template<typename T, typename T2, typename... TArgs> struct IndexOf<T, T2, TArgs...> : std::integral_constant<TypeIdIdx, 1 + IndexOf<T, TArgs...>::value> { };
+
+		// Components not belonging to a ComponentList get their index on first use, already checked against the list's range
+		// ComponentList members have constant indices, and claim their list's range the first time one of them is created
+		template<typename T, typename = void> struct TypeIdBitIdxOf
+		{
+			inline static TypeIdIdx get() { static TypeIdIdx idx{getNextTypeIdBitIdx()}; return idx; }
+			inline static void claim() noexcept { }
+		};
+		template<typename T> struct TypeIdBitIdxOf<T, typename VoidT<typename T::ComponentListType>::Type>
+		{
+			inline static constexpr TypeIdIdx get() noexcept { return T::ComponentListType::template getIdx<T>(); }
+			inline static void claim()
+			{
+				using List = typename T::ComponentListType;
+				static const bool claimed{(claimComponentList(List::getTag(), List::getSize()), true)}; (void)claimed;
+			}
+		};
 
 		// Shortcut to get the bit index of a Component type
-		template<typename T> inline const TypeIdIdx& getTypeIdBitIdx() noexcept
+		template<typename T> inline constexpr TypeIdIdx getTypeIdBitIdx()
 		{
 			static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
-			static TypeIdIdx idx{getNextTypeIdBitIdx()}; return idx;
+			return TypeIdBitIdxOf<T>::get();
 		}
 
 		// These functions use variadic template recursion to "build" a bitset for a set of Component types
-		template<typename T> inline void buildBitsetHelper(TypeIdsBitset& mBitset) noexcept { mBitset[getTypeIdBitIdx<T>()] = true; }
-		template<typename T1, typename T2, typename... TArgs> inline void buildBitsetHelper(TypeIdsBitset& mBitset) noexcept { buildBitsetHelper<T1>(mBitset); buildBitsetHelper<T2, TArgs...>(mBitset); }
-		template<typename... TArgs> inline TypeIdsBitset getBuildBitset() noexcept { TypeIdsBitset result; buildBitsetHelper<TArgs...>(result); return result; }
-		template<> inline TypeIdsBitset getBuildBitset<>() noexcept { static TypeIdsBitset nullBitset; return nullBitset; }
+		// Not noexcept: the first lookup of a runtime type can throw from getNextTypeIdBitIdx
+		template<typename T> inline void buildBitsetHelper(TypeIdsBitset& mBitset) { mBitset[getTypeIdBitIdx<T>()] = true; }
+		template<typename T1, typename T2, typename... TArgs> inline void buildBitsetHelper(TypeIdsBitset& mBitset) { buildBitsetHelper<T1>(mBitset); buildBitsetHelper<T2, TArgs...>(mBitset); }
+		template<typename... TArgs> inline TypeIdsBitset getBuildBitset() { TypeIdsBitset result; buildBitsetHelper<TArgs...>(result); return result; }
+		template<> inline TypeIdsBitset getBuildBitset<>() { static TypeIdsBitset nullBitset; return nullBitset; }
 
 		SSVU_DEFINE_HAS_MEMBER_CHECKER(HasAdded, added);
 		SSVU_DEFINE_HAS_MEMBER_CHECKER(HasRemoved, removed);
@@ -62,7 +128,7 @@ namespace ssvces
 		SSVU_DEFINE_HAS_MEMBER_INVOKER(callRemoved, removed, (HasRemoved<T, void(TArgs...)>::Value));
 
 		// Shortcut to get the static Bitset of a pack of Component types
-		template<typename... TArgs> inline const TypeIdsBitset& getTypeIdsBitset() noexcept { static TypeIdsBitset bitset{Internal::getBuildBitset<TArgs...>()}; return bitset; }
+		template<typename... TArgs> inline const TypeIdsBitset& getTypeIdsBitset() { static TypeIdsBitset bitset{Internal::getBuildBitset<TArgs...>()}; return bitset; }
 
 		// Returns whether the first bitset contains all the value of the second one
 		inline bool containsAll(const TypeIdsBitset& mA, const TypeIdsBitset& mB) noexcept { return (mA & mB) == mB; }
@@ -70,6 +136,21 @@ namespace ssvces
 		// Returns whether a type id bitset matches a system's type id bitset
 		inline bool matchesSystem(const TypeIdsBitset& mTypeIds, const SystemBase& mSystem) noexcept;
 	}
+
+	// Optional compile-time list of Component types: components deriving from `ComponentList<...>::Base` get a constant
+	// bit index equal to their position in the list, so type lookups fold to constants
+	// Only one ComponentList can be used, plus up to `maxComponents - size` runtime types: neither limit is visible to the
+	// compiler, so both are enforced at runtime by claimComponentList and getNextTypeIdBitIdx, which throw std::runtime_error
+	template<typename... TArgs> struct ComponentList
+	{
+		static_assert(sizeof...(TArgs) <= maxComponents, "Too many Component types in ComponentList");
+
+		struct Base : Component { using ComponentListType = ComponentList; };
+
+		template<typename T> inline static constexpr TypeIdIdx getIdx() noexcept { return Internal::IndexOf<T, TArgs...>::value; }
+		inline static constexpr std::size_t getSize() noexcept { return sizeof...(TArgs); }
+		inline static const void* getTag() noexcept { static const char tag{0}; return &tag; }
+	};
 }
 
 #endif
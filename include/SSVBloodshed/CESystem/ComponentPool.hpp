@@ -0,0 +1,60 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_CESYSTEM_COMPONENTPOOL
+#define SSVOB_CESYSTEM_COMPONENTPOOL
+
+#include "SSVBloodshed/CESystem/Common.hpp"
+
+namespace ssvces
+{
+	namespace Internal
+	{
+		class ComponentPoolBase : ssvu::NoCopy
+		{
+			public:
+				inline virtual ~ComponentPoolBase() noexcept { }
+				virtual void destroy(ComponentIdx mIdx) noexcept = 0;
+		};
+
+		template<typename T> class ComponentPool : public ComponentPoolBase
+		{
+			// ComponentPool stores every Component of type T in contiguous fixed-size chunks
+			// Chunks are never moved or freed while the pool is alive, so Component addresses are stable
+
+			private:
+				using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+				using Chunk = std::array<Storage, componentChunkSize>;
+
+				std::vector<Uptr<Chunk>> chunks;
+				std::vector<ComponentIdx> available;
+				ComponentIdx next{0};
+
+				inline Storage& getStorage(ComponentIdx mIdx) noexcept { return (*chunks[mIdx / componentChunkSize])[mIdx % componentChunkSize]; }
+
+				// Returns the index of a free slot, reusing reclaimed slots first and growing by one chunk when full
+				inline ComponentIdx getAvailable()
+				{
+					if(!available.empty()) { auto idx(available.back()); available.pop_back(); return idx; }
+					if(next == chunks.size() * componentChunkSize) chunks.emplace_back(new Chunk);
+					return next++;
+				}
+
+			public:
+				inline ~ComponentPool() noexcept { assert(available.size() == next); }
+
+				template<typename... TArgs> inline ComponentIdx create(TArgs&&... mArgs)
+				{
+					auto idx(getAvailable());
+					new(&getStorage(idx)) T(std::forward<TArgs>(mArgs)...);
+					return idx;
+				}
+				inline void destroy(ComponentIdx mIdx) noexcept override { (*this)[mIdx].~T(); available.emplace_back(mIdx); }
+
+				inline T& operator[](ComponentIdx mIdx) noexcept { assert(mIdx < next); return reinterpret_cast<T&>(getStorage(mIdx)); }
+		};
+	}
+}
+
+#endif
@@ -11,46 +11,52 @@ namespace ssvces
 {
 	class Manager;
 	class EntityHandle;
-	template<typename, typename, typename> class System;
+	template<typename, typename, typename, typename> class System;
 
 	class Entity : ssvu::NoCopy
 	{
 		friend class Manager;
 		friend class EntityHandle;
 		friend class Internal::SystemBase;
-		template<typename, typename, typename> friend class System;
+		template<typename, typename, typename, typename> friend class System;
 
 		private:
 			Manager& manager;
-			std::array<Uptr<Component>, maxComponents> components;
+			std::array<ComponentIdx, maxComponents> components;
 			TypeIdsBitset typeIds;
 			bool mustDestroy{false}, mustRematch{true};
 			GroupBitset groups;
 			EntityStat stat;
 			std::size_t componentCount{0};
 
+			inline void setMustRematch() noexcept;
+
+			// Immediate versions of the structural changes, used directly or when the Manager applies deferred commands
+			template<typename T, typename... TArgs> inline void createComponentNow(TArgs&&...);
+			inline void removeComponentNow(TypeIdIdx mTypeIdIdx) noexcept;
+			inline void destroyNow() noexcept;
+			inline void addGroupNow(Group mGroup) noexcept;
+			inline void delGroupNow(Group mGroup) noexcept;
+			inline void clearGroupsNow() noexcept;
+
 		public:
 			inline Entity(Manager& mManager, const EntityStat& mStat) noexcept : manager(mManager), stat(mStat) { }
+			inline ~Entity() noexcept;
 
 			template<typename T, typename... TArgs> inline void createComponent(TArgs&&...);
 			template<typename T> inline void removeComponent();
-			template<typename T> inline bool hasComponent() const noexcept
+			template<typename T> inline bool hasComponent() const
 			{
 				static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
 				return typeIds[Internal::getTypeIdBitIdx<T>()];
 			}
-			template<typename T> inline T& getComponent() noexcept
-			{
-				static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
-				assert(componentCount > 0 && hasComponent<T>());
-				return reinterpret_cast<T&>(*components[Internal::getTypeIdBitIdx<T>()]);
-			}
+			template<typename T> inline T& getComponent();
 
 			inline void destroy() noexcept;
 
 			inline Manager& getManager() noexcept { return manager; }
 
-			// Groups
+			// Groups, changes made while the Manager is deferring are applied on the next refresh like component changes
 			inline void setGroups(bool mOn, Group mGroup) noexcept;
 			inline void addGroups(Group mGroup) noexcept;
 			inline void delGroups(Group mGroup) noexcept;
@@ -7,33 +7,103 @@
 
 namespace ssvces
 {
+	inline Entity::~Entity() noexcept
+	{
+		// Components live in the Manager's pools, so they have to be given back explicitly
+		for(auto i(0u); i < maxComponents; ++i) if(typeIds[i]) manager.componentPools[i]->destroy(components[i]);
+	}
+
 	template<typename T, typename... TArgs> inline void Entity::createComponent(TArgs&&... mArgs)
 	{
 		static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
-		assert(!hasComponent<T>() && componentCount <= maxComponents);
-
-		components[Internal::getTypeIdBitIdx<T>()] = std::make_unique<T>(std::forward<TArgs>(mArgs)...);
-		typeIds[Internal::getTypeIdBitIdx<T>()] = true;
-		++componentCount;
+		if(!manager.isDeferring()) { createComponentNow<T>(std::forward<TArgs>(mArgs)...); return; }
 
-		mustRematch = true;
+		// The arguments are moved or copied into the command, as the originals may not outlive the current `process` call
+		// Pass references (e.g. to other components) with `std::ref`; the stored values are moved into the constructor,
+		// so a reference parameter given a plain copy fails to compile instead of binding to the copy
+		// The tuple is shared so the command stays copyable for `std::function` with move-only arguments
+		auto self(this);
+		auto args(std::make_shared<decltype(std::make_tuple(std::forward<TArgs>(mArgs)...))>(std::forward<TArgs>(mArgs)...));
+		manager.getCommandBuffer().defer([self, args]
+		{
+			ssvu::explode([self](auto&&... mXs){ self->createComponentNow<T>(std::forward<decltype(mXs)>(mXs)...); }, std::move(*args));
+		});
 	}
 	template<typename T> inline void Entity::removeComponent()
 	{
 		static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
 		assert(hasComponent<T>() && componentCount > 0);
 
-		components[Internal::getTypeIdBitIdx<T>()].reset();
-		typeIds[Internal::getTypeIdBitIdx<T>()] = false;
+		if(!manager.isDeferring()) removeComponentNow(Internal::getTypeIdBitIdx<T>());
+		else manager.getCommandBuffer().remove(*this, Internal::getTypeIdBitIdx<T>());
+	}
+	template<typename T, typename... TArgs> inline void Entity::createComponentNow(TArgs&&... mArgs)
+	{
+		// Both can throw if the Component types do not fit in the bitset, so they come before any noexcept lookup
+		Internal::TypeIdBitIdxOf<T>::claim();
+		auto idx(Internal::getTypeIdBitIdx<T>());
+		assert(!typeIds[idx] && componentCount <= maxComponents);
+
+		components[idx] = manager.getComponentPool<T>().create(std::forward<TArgs>(mArgs)...);
+		typeIds[idx] = true;
+		++componentCount;
+
+		setMustRematch();
+	}
+	inline void Entity::removeComponentNow(TypeIdIdx mTypeIdIdx) noexcept
+	{
+		assert(typeIds[mTypeIdIdx] && componentCount > 0);
+
+		manager.componentPools[mTypeIdIdx]->destroy(components[mTypeIdIdx]);
+		typeIds[mTypeIdIdx] = false;
 		--componentCount;
 
+		setMustRematch();
+	}
+	template<typename T> inline T& Entity::getComponent()
+	{
+		static_assert(ssvu::isBaseOf<Component, T>(), "Type must derive from Component");
+		assert(componentCount > 0 && hasComponent<T>());
+		return manager.getComponentPool<T>()[components[Internal::getTypeIdBitIdx<T>()]];
+	}
+	inline void Entity::setMustRematch() noexcept
+	{
+		// Only an entity that has already been matched can be in system tuples
+		if(!mustRematch && !mustDestroy) manager.toUnregister.emplace_back(this);
+		manager.mustRefreshEntities = true;
 		mustRematch = true;
 	}
-	inline void Entity::destroy() noexcept							{ mustDestroy = true; manager.entityIdPool.reclaim(stat); }
-	inline void Entity::setGroups(bool mOn, Group mGroup) noexcept	{ groups[mGroup] = mOn; if(mOn) manager.addToGroup(this, mGroup); }
-	inline void Entity::addGroups(Group mGroup) noexcept			{ groups[mGroup] = true; manager.addToGroup(this, mGroup); }
-	inline void Entity::delGroups(Group mGroup) noexcept			{ groups[mGroup] = false; }
-	inline void Entity::clearGroups() noexcept						{ groups.reset(); }
+	inline void Entity::destroy() noexcept
+	{
+		if(!manager.isDeferring()) destroyNow();
+		else manager.getCommandBuffer().destroy(*this);
+	}
+	inline void Entity::destroyNow() noexcept
+	{
+		if(!mustRematch && !mustDestroy) manager.toUnregister.emplace_back(this);
+		manager.mustRefreshEntities = true;
+		manager.groupsToRefresh |= groups;
+		mustDestroy = true; manager.entityIdPool.reclaim(stat);
+	}
+	inline void Entity::setGroups(bool mOn, Group mGroup) noexcept	{ if(mOn) addGroups(mGroup); else delGroups(mGroup); }
+	inline void Entity::addGroups(Group mGroup) noexcept
+	{
+		if(!manager.isDeferring()) { addGroupNow(mGroup); return; }
+		auto self(this); manager.getCommandBuffer().defer([self, mGroup]{ self->addGroupNow(mGroup); });
+	}
+	inline void Entity::delGroups(Group mGroup) noexcept
+	{
+		if(!manager.isDeferring()) { delGroupNow(mGroup); return; }
+		auto self(this); manager.getCommandBuffer().defer([self, mGroup]{ self->delGroupNow(mGroup); });
+	}
+	inline void Entity::clearGroups() noexcept
+	{
+		if(!manager.isDeferring()) { clearGroupsNow(); return; }
+		auto self(this); manager.getCommandBuffer().defer([self]{ self->clearGroupsNow(); });
+	}
+	inline void Entity::addGroupNow(Group mGroup) noexcept		{ groups[mGroup] = true; manager.addToGroup(this, mGroup); }
+	inline void Entity::delGroupNow(Group mGroup) noexcept		{ groups[mGroup] = false; manager.groupsToRefresh[mGroup] = true; }
+	inline void Entity::clearGroupsNow() noexcept				{ manager.groupsToRefresh |= groups; groups.reset(); }
 }
 
 #endif
@@ -23,7 +23,7 @@ namespace ssvces
 			inline EntityHandle(Entity& mEntity) noexcept : entity(mEntity), manager(entity.getManager()), stat(entity.stat) { }
 
 			template<typename T, typename... TArgs> inline void createComponent(TArgs&&... mArgs)	{ assert(isAlive()); entity.createComponent<T>(std::forward<TArgs>(mArgs)...); }
-			template<typename T> inline bool hasComponent() const noexcept							{ assert(isAlive()); return entity.hasComponent<T>(); }
+			template<typename T> inline bool hasComponent() const									{ assert(isAlive()); return entity.hasComponent<T>(); }
 			template<typename T> inline T& getComponent()											{ assert(isAlive()); return entity.getComponent<T>(); }
 
 			inline void destroy() noexcept { if(isAlive()) entity.destroy(); }
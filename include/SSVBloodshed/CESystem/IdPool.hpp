@@ -14,23 +14,28 @@ namespace ssvces
 		class IdPool
 		{
 			// IdPool stores available Entity ids and is used to check Entity validity
+			// Ids are created lazily in chunks, so memory scales with the peak number of live Entities
 
 			private:
+				static constexpr std::size_t chunkSize{1024};
 				std::vector<EntityId> available;
-				std::array<EntityIdCtr, maxEntities> counters;
+				std::vector<EntityIdCtr> counters;
 
-			public:
-				inline IdPool() : available(maxEntities)
+				// Makes `chunkSize` new ids available, lowest ids on top of the free list
+				inline void grow()
 				{
-					// Fill the available ids vector from 0 to maxEntities
-					std::iota(std::begin(available), std::end(available), 0);
-					std::fill(std::begin(counters), std::end(counters), 0);
+					auto first(counters.size()), last(std::min(first + chunkSize, maxEntities));
+					assert(first < last);
+
+					counters.resize(last, 0);
+					for(auto id(last); id > first; --id) available.emplace_back(id - 1);
 				}
 
+			public:
 				// Returns the first available IdCtrPair
-				inline EntityStat getAvailable() noexcept
+				inline EntityStat getAvailable()
 				{
-					assert(!available.empty());
+					if(available.empty()) grow();
 
 					EntityId id(available.back());
 					available.pop_back();
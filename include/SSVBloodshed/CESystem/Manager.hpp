@@ -5,10 +5,14 @@
 #ifndef SSVOB_CESYSTEM_MANAGER
 #define SSVOB_CESYSTEM_MANAGER
 
+#include <mutex>
+#include <thread>
 #include "SSVBloodshed/CESystem/Common.hpp"
 #include "SSVBloodshed/CESystem/Entity.hpp"
 #include "SSVBloodshed/CESystem/EntityHandle.hpp"
 #include "SSVBloodshed/CESystem/IdPool.hpp"
+#include "SSVBloodshed/CESystem/ComponentPool.hpp"
+#include "SSVBloodshed/CESystem/CommandBuffer.hpp"
 #include "SSVBloodshed/CESystem/System.hpp"
 
 namespace ssvces
@@ -17,23 +21,88 @@ namespace ssvces
 	{
 		friend class Entity;
 		friend class EntityHandle;
+		friend struct Internal::DeferScope;
 
 		private:
 			Internal::IdPool entityIdPool;
+			std::array<Uptr<Internal::ComponentPoolBase>, maxComponents> componentPools; // Must be declared before `entities`, which releases into it
 			std::vector<Internal::SystemBase*> systems;
+			std::unordered_map<TypeIdsBitset, std::vector<Internal::SystemBase*>> matchCache; // Archetype -> matching systems, cleared on system registration
 			std::vector<Uptr<Entity>> entities;
 			std::array<std::vector<Entity*>, maxGroups> grouped;
 
-			inline Entity* create(Manager& mManager, Internal::IdPool& mIdPool) { auto entity(new Entity{mManager, mIdPool.getAvailable()}); entities.emplace_back(entity); return entity; }
+			// Dirty flags set by entities, so that `refresh()` only does the work that is actually needed
+			GroupBitset groupsToRefresh;
+			std::vector<Entity*> toUnregister; // Matched entities that died or must be rematched
+			bool mustRefreshEntities{false};
+
+			// Structural changes requested during `processAll` go to per-thread command buffers
+			std::size_t uid{Internal::getNextManagerUid()};
+			std::atomic<std::size_t> deferDepth{0};
+			std::mutex commandBuffersMutex;
+			std::vector<std::pair<std::thread::id, Uptr<Internal::CommandBuffer>>> commandBuffers;
+
+			inline Entity* create(Manager& mManager, Internal::IdPool& mIdPool)
+			{
+				auto entity(new Entity{mManager, mIdPool.getAvailable()}); entities.emplace_back(entity);
+				mustRefreshEntities = true; return entity;
+			}
 
 			inline void addToGroup(Entity* mEntity, Group mGroup) { assert(mGroup <= maxGroups); grouped[mGroup].push_back(mEntity); }
 
+			template<typename T> inline Internal::ComponentPool<T>& getComponentPool()
+			{
+				auto& pool(componentPools[Internal::getTypeIdBitIdx<T>()]);
+				if(pool == nullptr) pool.reset(new Internal::ComponentPool<T>);
+				return static_cast<Internal::ComponentPool<T>&>(*pool);
+			}
+
+			inline const std::vector<Internal::SystemBase*>& getMatchingSystems(const TypeIdsBitset& mTypeIds)
+			{
+				auto itr(matchCache.find(mTypeIds));
+				if(itr != std::end(matchCache)) return itr->second;
+
+				auto& result(matchCache[mTypeIds]);
+				for(auto& s : systems) if(Internal::matchesSystem(mTypeIds, *s)) result.push_back(s);
+				return result;
+			}
+
+			inline bool isDeferring() const noexcept { return deferDepth > 0; }
+			inline Internal::CommandBuffer& getCommandBuffer()
+			{
+				// Every thread caches the buffer of the last Manager it recorded commands into
+				static thread_local std::size_t cachedUid{0};
+				static thread_local Internal::CommandBuffer* cachedBuffer{nullptr};
+				if(cachedUid == uid) return *cachedBuffer;
+
+				std::lock_guard<std::mutex> lock{commandBuffersMutex};
+				auto threadId(std::this_thread::get_id());
+				auto itr(std::find_if(std::begin(commandBuffers), std::end(commandBuffers), [&threadId](const decltype(commandBuffers)::value_type& mPair){ return mPair.first == threadId; }));
+				if(itr == std::end(commandBuffers)) { commandBuffers.emplace_back(threadId, Uptr<Internal::CommandBuffer>(new Internal::CommandBuffer)); itr = std::end(commandBuffers) - 1; }
+
+				cachedUid = uid; cachedBuffer = itr->second.get();
+				return *cachedBuffer;
+			}
+			inline void applyCommands()
+			{
+				assert(!isDeferring());
+				for(auto& p : commandBuffers)
+					p.second->apply([](Entity& mEntity){ mEntity.destroyNow(); }, [](Entity& mEntity, TypeIdIdx mIdx){ if(mEntity.typeIds[mIdx]) mEntity.removeComponentNow(mIdx); });
+			}
+
 		public:
 			inline void refresh()
 			{
-				for(auto& s : systems) s->refresh();
+				applyCommands();
+
+				if(!toUnregister.empty()) { for(auto& s : systems) s->refresh(toUnregister); toUnregister.clear(); }
 
-				for(auto i(0u); i < maxGroups; ++i) ssvu::eraseRemoveIf(grouped[i], [i](const Entity* mEntity){ return mEntity->mustDestroy || !mEntity->hasGroup(i); });
+				for(auto i(0u); i < maxGroups; ++i)
+					if(groupsToRefresh[i]) ssvu::eraseRemoveIf(grouped[i], [i](const Entity* mEntity){ return mEntity->mustDestroy || !mEntity->hasGroup(i); });
+				groupsToRefresh.reset();
+
+				if(!mustRefreshEntities) return;
+				mustRefreshEntities = false;
 
 				// This loop below is roughly implemented like std::remove_if
 				auto itr(std::begin(entities)), last(std::end(entities)), result(itr);
@@ -44,7 +113,7 @@ namespace ssvces
 					if(e.mustDestroy) continue;
 					if(e.mustRematch)
 					{
-						for(auto& s : systems) if(Internal::matchesSystem(e.typeIds, *s)) s->registerEntity(e);
+						for(auto& s : getMatchingSystems(e.typeIds)) s->registerEntity(e);
 						e.mustRematch = false;
 					}
 
@@ -54,10 +123,19 @@ namespace ssvces
 			}
 
 			inline EntityHandle createEntity() { return {*create(*this, entityIdPool)}; }
+
+			// Creates an entity and passes it to `mInit`, immediately or on the next refresh if systems are processing
+			template<typename TF> inline void createEntityDeferred(TF mInit)
+			{
+				if(!isDeferring()) { mInit(createEntity()); return; }
+				getCommandBuffer().defer([this, mInit]{ mInit(createEntity()); });
+			}
 			template<typename T> inline void registerSystem(T& mSystem)
 			{
 				static_assert(ssvu::isBaseOf<Internal::SystemBase, T>(), "Type must derive from SystemBase");
 				systems.push_back(&mSystem);
+				mSystem.manager = this;
+				matchCache.clear();
 			}
 
 			inline const decltype(entities)& getEntities() const noexcept				{ return entities; }
@@ -81,6 +159,9 @@ namespace ssvces
 
 	namespace Internal
 	{
+		inline DeferScope::DeferScope(Manager* mManager) noexcept : manager{mManager}	{ if(manager != nullptr) ++manager->deferDepth; }
+		inline DeferScope::~DeferScope() noexcept										{ if(manager != nullptr) --manager->deferDepth; }
+
 		inline bool matchesSystem(const TypeIdsBitset& mTypeIds, const SystemBase& mSystem) noexcept
 		{
 			return (mTypeIds & mSystem.typeIdsNot).none() && containsAll(mTypeIds, mSystem.typeIdsReq);
@@ -0,0 +1,87 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_CESYSTEM_SCHEDULER
+#define SSVOB_CESYSTEM_SCHEDULER
+
+#include "SSVBloodshed/CESystem/Common.hpp"
+#include "SSVBloodshed/CESystem/SystemBase.hpp"
+#include "SSVBloodshed/CESystem/ThreadPool.hpp"
+
+namespace ssvces
+{
+	class Scheduler : ssvu::NoCopy
+	{
+		// Scheduler runs a list of system updates, concurrently whenever they do not conflict
+		// Two updates conflict if one writes a component type the other one reads or writes, or if both are structural
+		// Structural updates are the ones that create/destroy entities or add/remove components outside of `processAll`
+		// Conflicting updates always run in the order they were added
+		// Updates must not use the Scheduler's ThreadPool themselves
+
+		private:
+			struct Node
+			{
+				TypeIdsBitset read, write;
+				bool structural;
+				std::function<void()> fn;
+				std::size_t wave;
+			};
+
+			ThreadPool& pool;
+			std::vector<Node> nodes;
+			std::vector<std::vector<std::size_t>> waves;
+			bool mustRebuild{false};
+
+			inline static bool conflicts(const Node& mA, const Node& mB) noexcept
+			{
+				if(mA.structural && mB.structural) return true;
+				return (mA.write & (mB.read | mB.write)).any() || (mB.write & mA.read).any();
+			}
+
+			// Every node is placed in the wave after the latest one containing a node it conflicts with
+			inline void rebuild()
+			{
+				waves.clear();
+
+				for(auto i(0u); i < nodes.size(); ++i)
+				{
+					auto& n(nodes[i]); n.wave = 0;
+					for(auto j(0u); j < i; ++j) if(conflicts(n, nodes[j])) n.wave = std::max(n.wave, nodes[j].wave + 1);
+
+					if(n.wave >= waves.size()) waves.resize(n.wave + 1);
+					waves[n.wave].emplace_back(i);
+				}
+
+				mustRebuild = false;
+			}
+
+		public:
+			inline Scheduler(ThreadPool& mPool) noexcept : pool(mPool) { }
+
+			template<typename T, typename TF> inline void add(T& mSystem, TF mFn, bool mStructural = false)
+			{
+				static_assert(ssvu::isBaseOf<Internal::SystemBase, T>(), "Type must derive from SystemBase");
+				nodes.emplace_back(Node{mSystem.typeIdsRead, mSystem.typeIdsWrite, mStructural, std::move(mFn), 0});
+				mustRebuild = true;
+			}
+
+			inline void run()
+			{
+				if(mustRebuild) rebuild();
+
+				for(const auto& w : waves)
+				{
+					// A wave with a single update is run directly, without going through the pool
+					if(w.size() == 1) { nodes[w[0]].fn(); continue; }
+
+					for(auto i : w) pool.push([this, i]{ nodes[i].fn(); });
+					pool.wait();
+				}
+			}
+
+			inline std::size_t getWaveCount() noexcept { if(mustRebuild) rebuild(); return waves.size(); }
+	};
+}
+
+#endif
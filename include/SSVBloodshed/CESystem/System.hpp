@@ -8,6 +8,7 @@
 #include "SSVBloodshed/CESystem/Common.hpp"
 #include "SSVBloodshed/CESystem/Entity.hpp"
 #include "SSVBloodshed/CESystem/SystemBase.hpp"
+#include "SSVBloodshed/CESystem/ThreadPool.hpp"
 
 namespace ssvces
 {
@@ -15,7 +16,7 @@ namespace ssvces
 	{
 		template<typename... TArgs> struct Filter
 		{
-			static constexpr const TypeIdsBitset& getTypeIds() noexcept { return Internal::getTypeIdsBitset<TArgs...>(); }
+			static constexpr const TypeIdsBitset& getTypeIds() { return Internal::getTypeIdsBitset<TArgs...>(); }
 		};
 
 		template<typename TPReq, typename TPArgs> struct ExpHelper;
@@ -45,36 +46,93 @@ namespace ssvces
 		}
 	};
 	template<typename... TArgs> struct Not : public Internal::Filter<TArgs...> { };
+	template<typename... TArgs> struct Read : public Internal::Filter<TArgs...> { };
 
-	template<typename TDerived, typename TReq, typename TNot = Not<>> class System : public Internal::SystemBase
+	template<typename TDerived, typename TReq, typename TNot = Not<>, typename TRead = Read<>> class System : public Internal::SystemBase
 	{
 		private:
 			using Tpl = typename TReq::TplType;
+
 			std::vector<Tpl> tuples;
+			std::vector<std::size_t> slots; // Entity id -> index in `tuples`
+			bool stableOrder{false};
+			std::size_t minParallel{minParallelEntities};
 
 			inline static constexpr Entity& getEntity(const Tpl& mTpl) noexcept { return *std::get<Entity*>(mTpl); }
 			inline TDerived& getThisDerived() noexcept { return *reinterpret_cast<TDerived*>(this); }
+			inline std::size_t& getSlot(const Entity& mEntity) noexcept { return slots[mEntity.stat.id]; }
 
-			inline void refresh() override
+			inline void refresh(const std::vector<Entity*>& mToUnregister) override
 			{
-				ssvu::eraseRemoveIf(tuples, [this](const Tpl& mTpl)
+				auto firstRemoved(tuples.size());
+
+				for(const auto& e : mToUnregister)
 				{
-					if(getEntity(mTpl).mustDestroy || getEntity(mTpl).mustRematch) { TReq::onRemoved(getThisDerived(), mTpl); return true; }
-					return false;
-				});
+					if(e->stat.id >= slots.size() || getSlot(*e) == Internal::nullSlot || &getEntity(tuples[getSlot(*e)]) != e) continue;
+
+					auto idx(getSlot(*e)); getSlot(*e) = Internal::nullSlot;
+					TReq::onRemoved(getThisDerived(), tuples[idx]);
+
+					if(stableOrder) { std::get<Entity*>(tuples[idx]) = nullptr; firstRemoved = std::min(firstRemoved, idx); continue; }
+
+					// Swap-and-pop: the last tuple takes the removed one's place
+					if(idx != tuples.size() - 1) { tuples[idx] = std::move(tuples.back()); getSlot(getEntity(tuples[idx])) = idx; }
+					tuples.pop_back();
+				}
+
+				if(firstRemoved >= tuples.size()) return;
+
+				// Stable order: a single compaction pass starting from the first removed tuple
+				tuples.erase(std::remove_if(std::begin(tuples) + firstRemoved, std::end(tuples), [](const Tpl& mTpl){ return std::get<Entity*>(mTpl) == nullptr; }), std::end(tuples));
+				for(auto i(firstRemoved); i < tuples.size(); ++i) getSlot(getEntity(tuples[i])) = i;
 			}
 			inline void registerEntity(Entity& mEntity) override
 			{
+				if(mEntity.stat.id >= slots.size()) slots.resize(mEntity.stat.id + 1, Internal::nullSlot);
+				getSlot(mEntity) = tuples.size();
+
 				auto tpl(TReq::createTuple(mEntity)); tuples.push_back(tpl);
 				TReq::onAdded(getThisDerived(), tpl);
 			}
 
+		protected:
+			// Keeps tuples in registration order when entities are removed, at the cost of an O(n) compaction
+			inline void setStableOrder(bool mValue) noexcept { stableOrder = mValue; }
+
+			// Systems with heavier `process` functions can lower this, as their break-even point comes earlier
+			inline void setMinParallelEntities(std::size_t mValue) noexcept { minParallel = mValue; }
+
 		public:
-			inline System() noexcept : SystemBase{TReq::getTypeIds(), TNot::getTypeIds()} { }
+			inline System() : SystemBase{TReq::getTypeIds(), TNot::getTypeIds(), TRead::getTypeIds()} { }
+			// Structural changes made in `process` are deferred until the next `Manager::refresh`
 			template<typename... TArgs> inline void processAll(TArgs&&... mArgs)
 			{
+				Internal::DeferScope deferScope{manager};
 				for(auto& t : tuples) TReq::onProcess(getThisDerived(), t, std::make_tuple(std::forward<TArgs>(mArgs)...));
 			}
+
+			// Splits the tuples in chunks processed concurrently on `mPool`, returning when all of them are done
+			// `process` may destroy entities and add/remove components, but must use `Manager::createEntityDeferred` to create entities
+			// Runs `processAll` instead when there are fewer than `minParallelEntities` tuples, see setMinParallelEntities
+			template<typename... TArgs> inline void processAllParallel(ThreadPool& mPool, const TArgs&... mArgs)
+			{
+				const auto count(tuples.size());
+				if(count < minParallel) { processAll(mArgs...); return; }
+
+				Internal::DeferScope deferScope{manager};
+				const auto chunkSize(std::max(minParallelChunkSize, count / (mPool.getThreadCount() * 4) + 1));
+
+				for(auto i(0u); i < count; i += chunkSize)
+				{
+					const auto last(std::min(i + chunkSize, count));
+					mPool.push([this, i, last, &mArgs...]
+					{
+						for(auto j(i); j < last; ++j) TReq::onProcess(getThisDerived(), tuples[j], std::make_tuple(mArgs...));
+					});
+				}
+
+				mPool.wait();
+			}
 	};
 }
 
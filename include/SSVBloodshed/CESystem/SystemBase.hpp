@@ -10,6 +10,7 @@
 namespace ssvces
 {
 	class Manager;
+	class Scheduler;
 	class Entity;
 
 	namespace Internal
@@ -18,16 +19,30 @@ namespace ssvces
 		{
 			friend bool matchesSystem(const TypeIdsBitset&, const SystemBase&) noexcept;
 			friend class ssvces::Manager;
+			friend class ssvces::Scheduler;
 
 			private:
 				TypeIdsBitset typeIdsReq, typeIdsNot;
+				TypeIdsBitset typeIdsRead, typeIdsWrite; // Required types are assumed to be written unless declared as read-only
 
 			protected:
-				inline SystemBase(TypeIdsBitset mTypeIdsReq) : typeIdsReq{std::move(mTypeIdsReq)} { }
-				inline SystemBase(TypeIdsBitset mTypeIdsReq, TypeIdsBitset mTypeIdsNot) : typeIdsReq{std::move(mTypeIdsReq)}, typeIdsNot{std::move(mTypeIdsNot)} { }
+				Manager* manager{nullptr}; // Set on registration
+
+				inline SystemBase(TypeIdsBitset mTypeIdsReq) : typeIdsReq{std::move(mTypeIdsReq)}, typeIdsWrite{typeIdsReq} { }
+				inline SystemBase(TypeIdsBitset mTypeIdsReq, TypeIdsBitset mTypeIdsNot) : typeIdsReq{std::move(mTypeIdsReq)}, typeIdsNot{std::move(mTypeIdsNot)}, typeIdsWrite{typeIdsReq} { }
+				inline SystemBase(TypeIdsBitset mTypeIdsReq, TypeIdsBitset mTypeIdsNot, TypeIdsBitset mTypeIdsRead) : typeIdsReq{std::move(mTypeIdsReq)}, typeIdsNot{std::move(mTypeIdsNot)},
+					typeIdsRead{std::move(mTypeIdsRead)}, typeIdsWrite{typeIdsReq & ~typeIdsRead} { }
 
 				virtual void registerEntity(Entity&) = 0;
-				virtual void refresh() = 0;
+				virtual void refresh(const std::vector<Entity*>& mToUnregister) = 0;
+		};
+
+		// While a DeferScope is alive, structural changes made to `mManager`'s entities are recorded and applied on refresh
+		struct DeferScope : ssvu::NoCopy
+		{
+			Manager* manager;
+			inline DeferScope(Manager* mManager) noexcept;
+			inline ~DeferScope() noexcept;
 		};
 	}
 }
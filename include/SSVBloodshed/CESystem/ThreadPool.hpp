@@ -0,0 +1,147 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_CESYSTEM_THREADPOOL
+#define SSVOB_CESYSTEM_THREADPOOL
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <exception>
+#include "SSVBloodshed/CESystem/Common.hpp"
+
+namespace ssvces
+{
+	class ThreadPool : ssvu::NoCopy
+	{
+		// ThreadPool runs batches of tasks on a fixed set of worker threads
+		// Every worker owns a queue and, when it runs dry, steals from the back of the other queues
+		// The thread calling `wait()` helps running tasks until the batch is done
+
+		public:
+			using Task = std::function<void()>;
+
+		private:
+			struct TaskQueue { std::mutex mutex; std::deque<Task> tasks; };
+
+			std::vector<Uptr<TaskQueue>> queues;
+			std::vector<std::thread> workers;
+			std::mutex sleepMutex;
+			std::condition_variable cvWork, cvDone;
+			std::atomic<std::size_t> queued{0}, pending{0}, nextQueue{0};
+			bool stopping{false};
+			std::exception_ptr error; // First exception thrown by a task of the current batch, rethrown by `wait()`, guarded by `sleepMutex`
+
+			inline bool tryPop(std::size_t mIdx, Task& mTask)
+			{
+				auto& q(*queues[mIdx]);
+				std::lock_guard<std::mutex> lock{q.mutex};
+				if(q.tasks.empty()) return false;
+
+				mTask = std::move(q.tasks.front()); q.tasks.pop_front();
+				return true;
+			}
+			inline bool trySteal(std::size_t mIdx, Task& mTask)
+			{
+				for(auto i(1u); i < queues.size(); ++i)
+				{
+					auto& q(*queues[(mIdx + i) % queues.size()]);
+					std::lock_guard<std::mutex> lock{q.mutex};
+					if(q.tasks.empty()) continue;
+
+					mTask = std::move(q.tasks.back()); q.tasks.pop_back();
+					return true;
+				}
+				return false;
+			}
+
+			// Runs a single task from the `mIdx` queue or stolen from another one, returns false if there were none
+			inline bool tryRunOne(std::size_t mIdx)
+			{
+				Task task;
+				if(!tryPop(mIdx, task) && !trySteal(mIdx, task)) return false;
+
+				--queued;
+
+				// `pending` must drop even if the task throws, or `wait()` would never return
+				struct PendingGuard
+				{
+					ThreadPool& pool;
+					inline ~PendingGuard() { if(--pool.pending == 0) { std::lock_guard<std::mutex> lock{pool.sleepMutex}; pool.cvDone.notify_all(); } }
+				} guard{*this};
+
+				try { task(); }
+				catch(...) { std::lock_guard<std::mutex> lock{sleepMutex}; if(error == nullptr) error = std::current_exception(); }
+
+				return true;
+			}
+
+			inline void workerLoop(std::size_t mIdx)
+			{
+				while(true)
+				{
+					if(tryRunOne(mIdx)) continue;
+
+					std::unique_lock<std::mutex> lock{sleepMutex};
+					cvWork.wait(lock, [this]{ return stopping || queued > 0; });
+					if(stopping) return;
+				}
+			}
+
+		public:
+			inline static std::size_t getDefaultThreadCount() noexcept { auto hc(std::thread::hardware_concurrency()); return hc > 1 ? hc - 1 : 1; }
+
+			// By default, spawns a worker for every hardware thread except the calling one
+			inline ThreadPool(std::size_t mThreadCount = getDefaultThreadCount())
+			{
+				assert(mThreadCount > 0);
+
+				for(auto i(0u); i < mThreadCount; ++i) queues.emplace_back(new TaskQueue);
+				for(auto i(0u); i < mThreadCount; ++i) workers.emplace_back([this, i]{ workerLoop(i); });
+			}
+			inline ~ThreadPool()
+			{
+				{ std::lock_guard<std::mutex> lock{sleepMutex}; stopping = true; }
+				cvWork.notify_all();
+				for(auto& w : workers) w.join();
+			}
+
+			// Schedules a task, distributing tasks round-robin between the worker queues
+			template<typename TF> inline void push(TF&& mFn)
+			{
+				++pending;
+
+				auto& q(*queues[nextQueue++ % queues.size()]);
+				{ std::lock_guard<std::mutex> lock{q.mutex}; q.tasks.emplace_back(std::forward<TF>(mFn)); }
+				++queued;
+
+				{ std::lock_guard<std::mutex> lock{sleepMutex}; }
+				cvWork.notify_one();
+			}
+
+			// Blocks until every pushed task has completed, running tasks on the calling thread meanwhile
+			// If any task threw, the first exception is rethrown here once the whole batch is done
+			inline void wait()
+			{
+				while(pending > 0)
+				{
+					if(tryRunOne(0)) continue;
+
+					std::unique_lock<std::mutex> lock{sleepMutex};
+					cvDone.wait(lock, [this]{ return pending == 0; });
+				}
+
+				std::exception_ptr toRethrow;
+				{ std::lock_guard<std::mutex> lock{sleepMutex}; std::swap(toRethrow, error); }
+				if(toRethrow != nullptr) std::rethrow_exception(toRethrow);
+			}
+
+			inline std::size_t getThreadCount() const noexcept { return workers.size(); }
+	};
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 #include "SSVBloodshed/Components/OBCIdReceiver.hpp"
+#include "SSVBloodshed/Particles/OBParticleRate.hpp"
 
 namespace ob
 {
@@ -19,6 +20,8 @@ namespace ob
 			bool active{true};
 			float alpha{0}, rad, forceMult;
 			ssvs::Animation animation;
+			OBParticleRate touchRate{60.f};	// Particles per second for every body touching
+			std::vector<Vec2f> touches;		// Positions of the bodies touching since the last update
 
 		public:
 			OBCBooster(OBCPhys& mCPhys, OBCDraw& mCDraw, OBCIdReceiver& mCIdReceiver, Dir8 mDir, float mForceMult) noexcept
@@ -41,8 +44,8 @@ namespace ob
 					if(!active) return;
 					const auto& dirVec(-ssvs::getVecFromRad(rad));
 
-					// When something touches the force field, spawn particles
-					game.createPForceField(1, toPixels(mDI.body.getPosition()));
+					// When something touches the force field, spawn particles in the next update
+					touches.emplace_back(toPixels(mDI.body.getPosition()));
 
 					if(forceMult > 0.f) mDI.body.applyAccel(dirVec * 30.f * forceMult);
 					else if(ssvs::getRad(mDI.body.getVelocity()) != ssvs::getRad(dirVec))
@@ -55,6 +58,13 @@ namespace ob
 
 			inline void update(FT mFT) override
 			{
+				if(!touches.empty())
+				{
+					auto count(touchRate.advance(mFT));
+					if(count > 0) for(const auto& p : touches) game.createPForceField(count, p);
+					touches.clear();
+				}
+
 				auto color(cDraw[0].getColor());
 
 				if(!active) color.a = 100;
@@ -0,0 +1,30 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_COMPONENTS_DRAWABLE
+#define SSVOB_COMPONENTS_DRAWABLE
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBGame.hpp"
+
+namespace ob
+{
+	class OBCDrawable : public sses::Component
+	{
+		// Draws a batch owned by the game (the static tile layer, the shard pool...) at the entity's draw priority
+
+		private:
+			OBGame& game;
+			const sf::Drawable& drawable;
+			sf::BlendMode blendMode;
+
+		public:
+			OBCDrawable(OBGame& mGame, const sf::Drawable& mDrawable, sf::BlendMode mBlendMode = sf::BlendMode::BlendAlpha) noexcept
+				: game(mGame), drawable(mDrawable), blendMode{mBlendMode} { }
+
+			inline void draw() override { game.render(drawable, blendMode); }
+	};
+}
+
+#endif
@@ -34,7 +34,8 @@ namespace ob
 				cKillable.getCHealth().setCooldown(0.45f);
 
 				body.addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir, OBGroup::GEnemy, OBGroup::GKillable, OBGroup::GEnemyKillable, OBGroup::GOrganic);
-				body.addGroupsToCheck(OBGroup::GSolidGround, OBGroup::GLevelBound);
+				body.addGroupsToCheck(OBGroup::GSolidGround);
+				cPhys.setTiles(true);
 				body.setRestitutionX(1.f);
 				body.setRestitutionY(1.f);
 
@@ -45,6 +46,7 @@ namespace ob
 					bounced = false;
 				};
 				body.onResolution += [this](const ResolutionInfo&){ bounced = true; };
+				cPhys.onTile += [this](const OBTileContact&){ bounced = true; };
 
 				cKillable.onDeath += [this]{ game.createEShard(1 + cKillable.getCHealth().getMaxHealth() / 3, cPhys.getPosI()); };
 			}
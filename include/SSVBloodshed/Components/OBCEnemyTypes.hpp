@@ -23,7 +23,8 @@
 
 namespace ob
 {
-	inline bool raycastToPlayer(OBCPhys& mSeeker, OBCPhys& mTarget, bool mCheckBulletForceField, bool mCheckForceField)
+	// Raycast against the bodies between the seeker and the target, plain walls are not bodies and are handled by OBLineOfSight
+	inline bool raycastBodiesToPlayer(OBCPhys& mSeeker, OBCPhys& mTarget, bool mCheckBulletForceField, bool mCheckForceField)
 	{
 		const auto& startPos(mSeeker.getPosI());
 		Vec2f dir(mTarget.getPosI() - startPos);
@@ -61,6 +62,14 @@ namespace ob
 		return false;
 	}
 
+	// Enemies in the same cell share the answer for the current frame, and the body raycast only runs if no static wall is in the way
+	inline bool raycastToPlayer(OBCPhys& mSeeker, OBCPhys& mTarget, bool mCheckBulletForceField, bool mCheckForceField)
+	{
+		int flags{int(mCheckBulletForceField) | int(mCheckForceField) << 1};
+		return mSeeker.getGame().getLineOfSight().canSee(mSeeker.getPosI(), &mTarget, mTarget.getPosI(), flags,
+			[&]{ return raycastBodiesToPlayer(mSeeker, mTarget, mCheckBulletForceField, mCheckForceField); });
+	}
+
 	class OBCEBase : public OBCActorBase
 	{
 		protected:
@@ -311,6 +320,7 @@ namespace ob
 							mRI.noResolvePosition = mRI.noResolveVelocity = true;
 					};
 					body.addGroupsToCheck(OBGroup::GSolidAir);
+					cPhys.setTiles(true);
 				}
 			}
 			inline void update(FT mFT) override
@@ -9,6 +9,7 @@
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 #include "SSVBloodshed/Components/OBCIdReceiver.hpp"
+#include "SSVBloodshed/Particles/OBParticleRate.hpp"
 
 namespace ob
 {
@@ -20,6 +21,8 @@ namespace ob
 			bool active{true}, blockFriendly, blockEnemy;
 			float distortion{0}, alpha{0}, rad, forceMult;
 			ssvs::Animation animation;
+			OBParticleRate touchRate{60.f};	// Particles per second for every body touching
+			std::vector<Vec2f> touches;		// Positions of the bodies touching since the last update
 
 		public:
 			OBCForceField(OBCPhys& mCPhys, OBCDraw& mCDraw, OBCIdReceiver& mCIdReceiver, Dir8 mDir, bool mBlockFriendly, bool mBlockEnemy, float mForceMult) noexcept
@@ -45,8 +48,8 @@ namespace ob
 
 					const auto& dirVec(-ssvs::getVecFromRad<float>(rad));
 
-					// When something touches the force field, spawn particles
-					game.createPForceField(1, toPixels(mDI.body.getPosition()));
+					// When something touches the force field, spawn particles in the next update
+					touches.emplace_back(toPixels(mDI.body.getPosition()));
 
 					distortion = 10;
 
@@ -72,6 +75,13 @@ namespace ob
 
 			inline void update(FT mFT) override
 			{
+				if(!touches.empty())
+				{
+					auto count(touchRate.advance(mFT));
+					if(count > 0) for(const auto& p : touches) game.createPForceField(count, p);
+					touches.clear();
+				}
+
 				auto color(cDraw[0].getColor());
 
 				if(!active) color.a = 100;
@@ -7,24 +7,30 @@
 
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBGame.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
 
 namespace ob
 {
 	class OBCIdReceiver : public sses::Component
 	{
 		private:
+			OBCPhys& cPhys;
+			OBIdRouter& idRouter;
 			int id;
 
 		public:
 			ssvu::Delegate<void(IdAction)> onActivate;
 
-			inline OBCIdReceiver(int mId) : id{mId} { }
-			inline void init() { getEntity().addGroups(OBGroup::GIdReceiver); }
+			inline OBCIdReceiver(OBCPhys& mCPhys, int mId) : cPhys(mCPhys), idRouter(mCPhys.getGame().getIdRouter()), id{mId} { }
+			inline ~OBCIdReceiver() override { idRouter.delReceiver(id, *this); }
+			inline void init() { getEntity().addGroups(OBGroup::GIdReceiver); idRouter.addReceiver(id, *this); }
 
 			inline void activate(IdAction mAction) { if(id != -1) onActivate(mAction); }
 
-			inline void setId(int mId) noexcept	{ id = mId; }
-			inline int getId() const noexcept	{ return id; }
+			inline void setId(int mId) { idRouter.delReceiver(id, *this); id = mId; idRouter.addReceiver(id, *this); }
+
+			inline OBCPhys& getCPhys() const noexcept	{ return cPhys; }
+			inline int getId() const noexcept			{ return id; }
 	};
 
 	inline void controlBoolByIdAction(OBCIdReceiver& mIdReceiver, bool& mValue) noexcept
@@ -13,18 +13,18 @@
 
 namespace ob
 {
-	inline void activateIdReceivers(OBCPhys& mCaller, int mId, IdAction mIdAction, sses::Manager& mManager)
+	inline void activateIdReceivers(OBCPhys& mCaller, int mId, IdAction mIdAction)
 	{
 		static sf::Color actionColors[]{sf::Color::Yellow, sf::Color::Green, sf::Color::Red};
 
-		for(auto& e : mManager.getEntities(OBGroup::GIdReceiver))
-		{
-			auto& cIdReceiver(e->getComponent<OBCIdReceiver>());
-			if(cIdReceiver.getId() != mId) continue;
+		// Copied, as activating a receiver could create or destroy other ones
+		auto receivers(mCaller.getGame().getIdRouter().getReceivers(mId));
+		if(receivers.empty()) return;
 
-			cIdReceiver.activate(mIdAction);
-			mCaller.getFactory().createTrail(mCaller.getPosI(), e->getComponent<OBCPhys>().getPosI(), actionColors[int(mIdAction)]);
-		}
+		// One trail entity per activation, with a line to every receiver
+		std::vector<Vec2i> targets;
+		for(const auto& r : receivers) { r->activate(mIdAction); targets.emplace_back(r->getCPhys().getPosI()); }
+		mCaller.getFactory().createTrail(mCaller.getPosI(), targets, actionColors[int(mIdAction)]);
 	}
 
 	class OBCPPlate : public OBCActorBase, public OBWeightable
@@ -34,62 +34,79 @@ namespace ob
 			PPlateType type;
 			IdAction idAction;
 			bool triggered{false};
+			Vec2i pos; // Plates never move, the position is kept to unregister without touching other components
 
-			inline std::vector<OBCPPlate*> getNeighbors()
+			// Adjacent plates with the same id and type, and all the plates connected to this one through them (itself included)
+			// Rebuilt from the game's OBIdRouter whenever a plate is added or removed
+			std::vector<OBCPPlate*> neighbors, cluster;
+			std::size_t platesVersion{std::size_t(-1)};
+
+			inline bool isLinked(const OBCPPlate* mPlate) const noexcept { return mPlate != nullptr && mPlate->id == id && mPlate->type == type; }
+
+			inline void refreshLinks()
 			{
-				std::vector<OBCPPlate*> result;
-				auto query(cPhys.getWorld().getQuery<ssvsc::QueryType::Distance>(cPhys.getPosI(), 1000));
+				const auto& idRouter(game.getIdRouter());
+				if(platesVersion == idRouter.getPlatesVersion()) return;
+				platesVersion = idRouter.getPlatesVersion();
 
-				Body* body;
-				while((body = query.next()) != nullptr)
+				auto getAdjacent = [&idRouter](const OBCPPlate& mPlate) -> std::array<OBCPPlate*, 4>
 				{
-					if(!body->hasGroup(OBGroup::GPPlate)) continue;
+					int x{OBTileLayer::getCell(mPlate.pos.x)}, y{OBTileLayer::getCell(mPlate.pos.y)};
+					return std::array<OBCPPlate*, 4>{{idRouter.getPlate(x - 1, y), idRouter.getPlate(x + 1, y), idRouter.getPlate(x, y - 1), idRouter.getPlate(x, y + 1)}};
+				};
 
-					auto& cPPlate(getEntityFromBody(*body).getComponent<OBCPPlate>());
-					if(cPPlate.cPhys.getPosI().x == cPhys.getPosI().x || cPPlate.cPhys.getPosI().y == cPhys.getPosI().y)
-						if(cPPlate.id == id && cPPlate.type == type) result.push_back(&cPPlate);
-				}
-
-				return result;
-			}
+				neighbors.clear();
+				for(const auto& p : getAdjacent(*this)) if(isLinked(p)) neighbors.push_back(p);
 
-			inline void triggerNeighbors(bool mTrigger)
-			{
-				for(const auto& n : getNeighbors()) if(mTrigger) n->trigger(); else n->unTrigger();
+				cluster.clear(); cluster.push_back(this);
+				for(auto i(0u); i < cluster.size(); ++i)
+					for(const auto& p : getAdjacent(*cluster[i]))
+						if(isLinked(p) && std::find(std::begin(cluster), std::end(cluster), p) == std::end(cluster)) cluster.push_back(p);
 			}
 
 			inline bool isAnyNeighborWeighted()
 			{
-				for(const auto& n : getNeighbors()) if(n->isWeighted()) return true;
+				refreshLinks();
+				for(const auto& n : neighbors) if(n->isWeighted()) return true;
 				return false;
 			}
 
-			inline void trigger()	{ if(!triggered) { triggered = true; triggerNeighbors(true); cDraw[0].setColor(sf::Color(100, 100, 100, 255)); } }
-			inline void unTrigger()	{ if(triggered) { triggered = false; triggerNeighbors(false); cDraw[0].setColor(sf::Color::White); } }
+			inline void setTriggered(bool mValue) { triggered = mValue; cDraw[0].setColor(mValue ? sf::Color(100, 100, 100, 255) : sf::Color::White); }
+			inline void setClusterTriggered(bool mValue)
+			{
+				refreshLinks();
+				for(const auto& p : cluster) if(p->triggered != mValue) p->setTriggered(mValue);
+			}
 
 		public:
 			OBCPPlate(OBCPhys& mCPhys, OBCDraw& mCDraw, int mId, PPlateType mType, IdAction mIdAction, bool mPlayerOnly) noexcept
 				: OBCActorBase{mCPhys, mCDraw}, OBWeightable{mCPhys, mPlayerOnly}, id{mId}, type{mType}, idAction{mIdAction} { }
+			inline ~OBCPPlate() override { game.getIdRouter().delPlate(pos, *this); }
 
-			inline void init() { OBWeightable::init(); body.addGroups(OBGroup::GPPlate); }
+			inline void init()
+			{
+				OBWeightable::init(); body.addGroups(OBGroup::GPPlate);
+				pos = cPhys.getPosI(); game.getIdRouter().addPlate(pos, *this);
+			}
 			inline void update(FT) override
 			{
 				if(hasBeenWeighted() && !triggered)
 				{
-					trigger(); activateIdReceivers(cPhys, id, idAction, manager);
+					setClusterTriggered(true); activateIdReceivers(cPhys, id, idAction);
 				}
 				else if(hasBeenUnweighted() && !isAnyNeighborWeighted())
 				{
-					if(type == PPlateType::Multi) unTrigger();
-					else if(type == PPlateType::OnOff) { unTrigger(); activateIdReceivers(cPhys, id, idAction, manager); }
+					if(type == PPlateType::Multi) setClusterTriggered(false);
+					else if(type == PPlateType::OnOff) { setClusterTriggered(false); activateIdReceivers(cPhys, id, idAction); }
 				}
 
 				OBWeightable::refresh();
 			}
 			inline void draw() override {  }
 
-			inline void setId(int mId) noexcept	{ id = mId; }
-			inline int getId() const noexcept	{ return id; }
+			// Changing the id changes which plates are linked, so every cached cluster is invalidated
+			inline void setId(int mId) { auto& idRouter(game.getIdRouter()); idRouter.delPlate(pos, *this); id = mId; idRouter.addPlate(pos, *this); }
+			inline int getId() const noexcept { return id; }
 	};
 }
 
@@ -9,6 +9,7 @@
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 #include "SSVBloodshed/Components/OBCParticleSystem.hpp"
+#include "SSVBloodshed/Particles/OBParticleRate.hpp"
 
 namespace ob
 {
@@ -20,12 +21,21 @@ namespace ob
 		private:
 			Vec2f offset;
 			GameParticleMemFn particleMemFn;
-			std::size_t count;
+			OBParticleRate rate;
 
 		public:
-			OBCParticleEmitter(OBCPhys& mCPhys, GameParticleMemFn mParticleMemFn, std::size_t mCount = 1) : OBCActorNoDrawBase{mCPhys}, particleMemFn{mParticleMemFn}, count{mCount} { }
-
-			inline void update(FT) override { (game.*particleMemFn)(count, cPhys.getPosPx() + offset); }
+			// `mCount` is the number of particles emitted per update at 60 FPS, the actual rate is `mCount * 60` particles per second
+			OBCParticleEmitter(OBCPhys& mCPhys, GameParticleMemFn mParticleMemFn, std::size_t mCount = 1) : OBCActorNoDrawBase{mCPhys}, particleMemFn{mParticleMemFn}, rate{mCount * 60.f} { }
+
+			// Emits as many particles as the elapsed time allows, in a single call so they are batched together
+			inline void update(FT mFT) override
+			{
+				auto count(rate.advance(mFT));
+				if(count > 0) (game.*particleMemFn)(count, cPhys.getPosPx() + offset);
+			}
+
+			inline void setPerSecond(float mPerSecond) noexcept						{ rate.setPerSecond(mPerSecond); }
+			inline void setBurst(std::size_t mCount, float mIntervalSeconds) noexcept	{ rate.setBurst(mCount, mIntervalSeconds); }
 
 			inline void setOffset(const Vec2f& mOffset) noexcept	{ offset = mOffset; }
 			inline const Vec2f& getOffset() const noexcept			{ return offset; }
@@ -30,11 +30,15 @@ namespace ob
 				renderTexture.clear(sf::Color::Transparent);
 				sprite.setTexture(renderTexture.getTexture());
 				sprite.setColor({255, 255, 255, alpha});
+
+				// A never-cleared texture keeps everything drawn on it, so resting particles can be baked into it
+				particleSystem.setBakeDecals(!clearOnDraw);
 			}
-			inline void update(FT mFT) override { particleSystem.update(mFT); }
+			// The particle system itself is updated by OBGParticles, together with the other ones
 			inline void draw() override
 			{
 				renderTexture.draw(particleSystem);
+				particleSystem.clearDecals();
 				renderTexture.display();
 				renderTarget.draw(sprite, blendMode);
 				if(clearOnDraw) renderTexture.clear(sf::Color::Transparent);
@@ -19,20 +19,26 @@ namespace ob
 			Body& body;
 			Vec2i lastResolution;
 			int crushedLeft{0}, crushedRight{0}, crushedTop{0}, crushedBottom{0};
+			bool tilesCheck{false}, tilesResolve{true};
+
+			inline void setCrushed(const Vec2i& mResolution) noexcept
+			{
+				lastResolution = mResolution;
+				if(lastResolution.x > 0) crushedLeft = crushedMax; else if(lastResolution.x < 0) crushedRight = crushedMax;
+				if(lastResolution.y > 0) crushedTop = crushedMax; else if(lastResolution.y < 0) crushedBottom = crushedMax;
+			}
 
 		public:
+			// Called for every cell of the game's OBTileLayer (plain walls and level bounds) the body touches, see setTiles()
+			ssvu::Delegate<void(const OBTileContact&)> onTile;
+
 			OBCPhys(OBGame& mGame, bool mIsStatic, const Vec2i& mPosition, const Vec2i& mSize) : game(mGame), world(mGame.getWorld()), body(world.create(mPosition, mSize, mIsStatic)) { }
 			inline ~OBCPhys() override { body.destroy(); }
 
 			inline void init()
 			{
 				body.setUserData(&getEntity());
-				body.onResolution += [this](const ResolutionInfo& mRI)
-				{
-					lastResolution = mRI.resolution;
-					if(lastResolution.x > 0) crushedLeft = crushedMax; else if(lastResolution.x < 0) crushedRight = crushedMax;
-					if(lastResolution.y > 0) crushedTop = crushedMax; else if(lastResolution.y < 0) crushedBottom = crushedMax;
-				};
+				body.onResolution += [this](const ResolutionInfo& mRI){ setCrushed(mRI.resolution); };
 				body.onPreUpdate += [this]
 				{
 					lastResolution = ssvs::zeroVec2i;
@@ -41,12 +47,25 @@ namespace ob
 					if(crushedTop > 0) --crushedTop;
 					if(crushedBottom > 0) --crushedBottom;
 				};
+				body.onPostUpdate += [this]
+				{
+					if(!tilesCheck) return;
+					game.getTileLayer().collide(body, tilesResolve, [this](const OBTileContact& mTC)
+					{
+						if(tilesResolve) setCrushed(mTC.resolution);
+						onTile(mTC);
+					});
+				};
 			}
 
 			inline void setPos(const Vec2i& mPos) noexcept			{ body.setPosition(mPos); }
 			inline void setVel(const Vec2f& mVel) noexcept			{ body.setVelocity(mVel); }
 			inline void setMass(float mMass) noexcept				{ body.setMass(mMass); }
 
+			// Static tiles are not bodies, so they are checked separately after the body's update
+			// `mResolve` false only detects them, like a body with the tiles' groups in its no-resolve groups
+			inline void setTiles(bool mCheck, bool mResolve = true) noexcept { tilesCheck = mCheck; tilesResolve = mResolve; }
+
 			inline OBGame& getGame() const noexcept					{ return game; }
 			inline OBFactory& getFactory() const noexcept			{ return game.getFactory(); }
 			inline World& getWorld() const noexcept					{ return world; }
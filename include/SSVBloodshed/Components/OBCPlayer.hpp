@@ -64,6 +64,7 @@ namespace ob
 		public:
 			OBCPlayer(OBCPhys& mCPhys, OBCDraw& mCDraw, OBCKillable& mCKillable, OBCWielder& mCWielder, OBCWpnController& mCWpnController) noexcept
 				: OBCActorBase{mCPhys, mCDraw}, cKillable(mCKillable), cWielder(mCWielder), cDir8(mCWielder.getCDir8()), cWpnController(mCWpnController) { }
+			inline ~OBCPlayer() override { auto& targetIndex(game.getTargetIndex()); targetIndex.del(OBGroup::GFriendly, cPhys); targetIndex.del(OBGroup::GPlayer, cPhys); }
 
 			inline void init()
 			{
@@ -76,7 +77,11 @@ namespace ob
 				getEntity().addGroups(OBGroup::GFriendly, OBGroup::GFriendlyKillable, OBGroup::GPlayer);
 				body.addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir, OBGroup::GFriendly, OBGroup::GKillable, OBGroup::GFriendlyKillable, OBGroup::GOrganic, OBGroup::GPlayer);
 				body.addGroupsToCheck(OBGroup::GSolidGround);
-				body.onResolution += [this](const ResolutionInfo& mRI){ if(mRI.body.hasGroup(OBGroup::GLevelBound)) checkTransitions(); };
+				cPhys.setTiles(true);
+				cPhys.onTile += [this](const OBTileContact& mTC){ if(mTC.bound) checkTransitions(); };
+
+				auto& targetIndex(game.getTargetIndex());
+				targetIndex.add(OBGroup::GFriendly, cPhys, body); targetIndex.add(OBGroup::GPlayer, cPhys, body);
 			}
 
 			inline void updateInput()
@@ -101,26 +106,12 @@ namespace ob
 
 			inline void attractShards()
 			{
-				if(!game.isLevelClear())
-				{
-					auto query(cPhys.getWorld().getQuery<ssvsc::QueryType::Distance>(cPhys.getPosI(), 3500));
+				auto& shardPool(game.getShards());
+				if(!game.isLevelClear()) shardPool.attract(cPhys.getPosF(), 3500, 0.004f);
+				else shardPool.vacuum(cPhys.getPosF());
 
-					Body* body;
-					while((body = query.next()) != nullptr) if(body->hasGroup(OBGroup::GShard)) body->applyAccel(Vec2f(cPhys.getPosI() - body->getPosition()) * 0.004f);
-				}
-				else
-				{
-					for(auto& e : manager.getEntities(OBGroup::GShard))
-					{
-						auto& c(e->getComponent<OBCPhys>());
-						c.getBody().addGroupsNoResolve(OBGroup::GSolidGround);
-						if(ssvs::getDistEuclidean(c.getPosI(), cPhys.getPosI()) > 6500)
-						{
-							if(ssvs::getMag(c.getVel()) < 650.f) c.getBody().applyAccel(Vec2f(cPhys.getPosI() - c.getPosI()) * 0.002f);
-						}
-						else c.setVel(ssvs::getMClampedMax(Vec2f(cPhys.getPosI() - c.getPosI()) / 1.5f, 400.f));
-					}
-				}
+				auto halfSize(Vec2f(body.getSize()) / 2.f);
+				currentShards += shardPool.collect(cPhys.getPosF(), halfSize, [this](const Vec2f& mPosPx){ game.createPShard(20, mPosPx); });
 			}
 
 			void updateHUD();
@@ -134,7 +125,7 @@ namespace ob
 
 			inline void update(FT) override
 			{
-				updateInput(); updateHUD(); attractShards();
+				checkCurrentVM(); updateInput(); updateHUD(); attractShards();
 
 				if(game.isLevelClear()) { shards += currentShards; currentShards = 0; }
 				if(cWielder.isShooting()) cWpnController.shoot(cWielder.getShootingPos(), cDir8.getDeg(), cWielder.getShootingPosPx());
@@ -147,9 +138,8 @@ namespace ob
 					for(int i{0}; i < 360; i += 360 / 16) factory.createPJTestBomb(body.getPosition(), cDir8.getDeg() + (i * (360 / 16)), 2.f - k * 0.2f + i * 0.004f, 4.f + k * 0.3f - i * 0.004f);
 			}
 
-			inline void shardGrabbed() noexcept { ++currentShards; }
-
 			void setCurrentVM(OBCVMachine* mVMachine);
+			void checkCurrentVM();
 			inline OBCVMachine* getCurrentVM() { return currentVM; }
 
 			inline void initFromData(const Data& mData) noexcept
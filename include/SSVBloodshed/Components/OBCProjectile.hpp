@@ -23,6 +23,7 @@ namespace ob
 			OBGroup targetGroup{OBGroup::GEnemyKillable};
 			float acceleration{0.f}, minSpeed{0}, maxSpeed{1000};
 			bool bounce{false}, fallInPit{false};
+			bool destroyed{false}; // A step can touch several tiles or bodies, only the first hit counts
 			float dmgMult{1.f};
 
 			inline void refreshMult()
@@ -32,6 +33,14 @@ namespace ob
 				else dmgMult = OBConfig::getDmgMultGlobal();
 			}
 
+			inline void hitWall()
+			{
+				if(bounce || destroyed) return;
+				game.createPDebris(6, cPhys.getPosPx());
+				assets.playSound("Sounds/bulletHitWall.wav");
+				destroy();
+			}
+
 		public:
 			ssvu::Delegate<void()> onDestroy;
 
@@ -45,6 +54,7 @@ namespace ob
 				body.setResolve(false);
 				body.onDetection += [this](const DetectionInfo& mDI)
 				{
+					if(destroyed) return;
 					if(fallInPit && mDI.body.hasGroup(OBGroup::GPit)) getEntity().destroy();
 
 					if(killDestructible && mDI.body.hasGroup(OBGroup::GEnvDestructible))
@@ -57,20 +67,16 @@ namespace ob
 					{
 						destroy();
 					}
-					else if(!mDI.body.hasGroup(OBGroup::GOrganic) && mDI.body.hasGroup(OBGroup::GSolidAir))
-					{
-						if(bounce) return;
-						game.createPDebris(6, cPhys.getPosPx());
-						assets.playSound("Sounds/bulletHitWall.wav");
-						destroy();
-					}
+					else if(!mDI.body.hasGroup(OBGroup::GOrganic) && mDI.body.hasGroup(OBGroup::GSolidAir)) hitWall();
 				};
+				cPhys.setTiles(true, bounce);
+				cPhys.onTile += [this](const OBTileContact&){ hitWall(); };
 				body.setRestitutionX(1.f);
 				body.setRestitutionY(1.f);
 
 				refreshMult();
 			}
-			inline void destroy() { getEntity().destroy(); onDestroy(); }
+			inline void destroy() { if(destroyed) return; destroyed = true; getEntity().destroy(); onDestroy(); }
 
 			inline void update(FT mFT) override
 			{
@@ -100,7 +106,7 @@ namespace ob
 			inline void setAcceleration(float mValue) noexcept		{ acceleration = mValue; }
 			inline void setMinSpeed(float mValue) noexcept			{ minSpeed = mValue; }
 			inline void setMaxSpeed(float mValue) noexcept			{ maxSpeed = mValue; }
-			inline void setBounce(bool mValue) noexcept				{ bounce = mValue; body.setResolve(bounce); }
+			inline void setBounce(bool mValue) noexcept				{ bounce = mValue; body.setResolve(bounce); cPhys.setTiles(true, bounce); }
 			inline void setSpeed(float mValue) noexcept				{ body.setVelocity(ssvs::getResized(body.getVelocity(), mValue)); }
 			inline void setFallInPit(bool mValue) noexcept			{ fallInPit = mValue; }
 
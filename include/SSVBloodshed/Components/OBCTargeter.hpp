@@ -22,21 +22,14 @@ namespace ob
 		public:
 			OBCTargeter(OBCPhys& mCPhys, OBGroup mTargetGroup) noexcept : OBCActorNoDrawBase{mCPhys}, targetGroup(mTargetGroup) { }
 
+			// Retargets to the nearest member of the target group every frame, through the game's shared target index
 			inline void update(FT) override
 			{
-				if(target == nullptr)
-				{
-					if(manager.hasEntity(targetGroup))
-					{
-						const auto& e(manager.getEntities(targetGroup).front());
-						targetStat = e->getStat(); target = &e->getComponent<OBCPhys>();
-					}
-				}
-				else
-				{
-					distance = ssvs::getDistEuclidean(target->getPosF(), cPhys.getPosF());
-					if(!manager.isAlive(targetStat)) target = nullptr;
-				}
+				const auto* nearest(game.getTargetIndex().getNearest(targetGroup, cPhys.getPosF()));
+				if(nearest == nullptr) { target = nullptr; return; }
+
+				target = nearest->cPhys; targetStat = target->getEntity().getStat();
+				distance = ssvs::getDistEuclidean(nearest->pos, cPhys.getPosF());
 			}
 
 			inline bool hasTarget() const noexcept			{ return target != nullptr && manager.isAlive(targetStat); }
@@ -12,24 +12,36 @@ namespace ob
 {
 	class OBCTrail : public sses::Component
 	{
+		// Flickering lines from one origin to any number of targets, fading out over time
+
 		private:
 			OBGame& game;
 			float life{75};
-			Vec2f a, b;
+			Vec2f a;
+			std::vector<Vec2f> bs;
 			sf::Color color;
 			ssvs::VertexVector<sf::PrimitiveType::Lines> vertices;
 
 		public:
-			OBCTrail(OBGame& mGame, const Vec2i& mA, const Vec2i& mB, sf::Color mColor) : game(mGame), a{toPixels(mA)}, b{toPixels(mB)}, color{std::move(mColor)}, vertices{2} { }
+			OBCTrail(OBGame& mGame, const Vec2i& mA, const std::vector<Vec2i>& mBs, sf::Color mColor) : game(mGame), a{toPixels(mA)}, color{std::move(mColor)}, vertices{mBs.size() * 2}
+			{
+				for(const auto& b : mBs) bs.emplace_back(toPixels(b));
+			}
 
 			inline void update(FT mFT) override
 			{
 				life -= mFT;
 				if(life <= 0) getEntity().destroy();
 				color.a = life * (255 / 100);
-				vertices[0].color = vertices[1].color = color;
-				vertices[0].position = a + Vec2f(ssvu::getRnd(-1, 1), ssvu::getRnd(-1, 1));
-				vertices[1].position = b + Vec2f(ssvu::getRnd(-1, 1), ssvu::getRnd(-1, 1));
+
+				for(auto i(0u); i < bs.size(); ++i)
+				{
+					auto& va(vertices[i * 2]);
+					auto& vb(vertices[i * 2 + 1]);
+					va.color = vb.color = color;
+					va.position = a + Vec2f(ssvu::getRnd(-1, 1), ssvu::getRnd(-1, 1));
+					vb.position = bs[i] + Vec2f(ssvu::getRnd(-1, 1), ssvu::getRnd(-1, 1));
+				}
 			}
 			inline void draw() override { game.render(vertices); }
 	};
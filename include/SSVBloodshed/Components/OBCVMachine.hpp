@@ -17,25 +17,35 @@ namespace ob
 		private:
 			float healAmount{1};
 			int shardCost{10};
+			float range{1300.f};
 			std::string msg{"[" + ssvu::toStr(shardCost) + "] Heal <" + ssvu::toStr(healAmount) + "> hp"};
 
 		public:
 			OBCVMachine(OBCPhys& mCPhys, OBCDraw& mCDraw) noexcept : OBCActorBase{mCPhys, mCDraw} { }
 
+			// Players keep a raw pointer to the machine they stand near, it must not outlive the machine
+			inline ~OBCVMachine() override
+			{
+				game.getTargetIndex().forAll(OBGroup::GPlayer, [this](OBCPhys& mCPhys)
+				{
+					auto& cPlayer(mCPhys.getEntity().getComponent<OBCPlayer>());
+					if(cPlayer.getCurrentVM() == this) cPlayer.setCurrentVM(nullptr);
+				});
+			}
+
 			inline void init() { body.setResolve(false); }
 
+			// Only visits the players in range; players that walk away clear the machine themselves in checkCurrentVM()
 			inline void update(FT) override
 			{
-				for(auto& e : manager.getEntities(OBGroup::GPlayer))
+				game.getTargetIndex().forWithin(OBGroup::GPlayer, cPhys.getPosF(), range, [this](const OBTarget& mT)
 				{
-					auto& cPhys(e->getComponent<OBCPhys>());
-					auto& cPlayer(e->getComponent<OBCPlayer>());
-
-					if(ssvs::getDistEuclidean(cPhys.getPosI(), body.getPosition()) < 1300) cPlayer.setCurrentVM(this);
-					else if(cPlayer.getCurrentVM() == this) cPlayer.setCurrentVM(nullptr);
-				}
+					mT.cPhys->getEntity().getComponent<OBCPlayer>().setCurrentVM(this);
+				});
 			}
 
+			inline bool isInRange(const Vec2f& mPos) const noexcept { return ssvs::getDistEuclidean(mPos, cPhys.getPosF()) < range; }
+
 			inline float getHealAmount() const noexcept			{ return healAmount; }
 			inline int getShardCost() const noexcept			{ return shardCost; }
 			inline const std::string& getMsg() const noexcept	{ return msg; }
@@ -52,6 +62,7 @@ namespace ob
 	}
 
 	inline void OBCPlayer::setCurrentVM(OBCVMachine* mVMachine) { currentVM = mVMachine; }
+	inline void OBCPlayer::checkCurrentVM() { if(currentVM != nullptr && !currentVM->isInRange(cPhys.getPosF())) currentVM = nullptr; }
 	inline void OBCPlayer::useVM()
 	{
 		if(currentVM->getShardCost() > shards + currentShards) return;
@@ -7,7 +7,7 @@
 
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
-#include "SSVBloodshed/Particles/OBParticleData.hpp"
+#include "SSVBloodshed/Particles/OBParticlePreset.hpp"
 
 namespace ob
 {
@@ -15,6 +15,14 @@ namespace ob
 	{
 		private:
 			ssvs::AssetManager assetManager;
+			std::vector<OBParticlePreset> particlePresets;
+
+			inline std::size_t loadParticlePreset(const std::string& mName, OBParticleTarget mTarget)
+			{
+				auto data(ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/" + mName + ".json")));
+				particlePresets.emplace_back(compileParticlePreset(mName, data, mTarget));
+				return particlePresets.size() - 1;
+			}
 
 		public:
 			ssvs::SoundPlayer soundPlayer;
@@ -75,11 +83,11 @@ namespace ob
 			// Animations
 			ssvs::Animation aForceField, aBulletBooster;
 
-			// Particle data
-			OBParticleData pdBloodRed,		pdGibRed,		pdExplosion,	pdDebris,		pdDebrisFloor;
-			OBParticleData pdMuzzleBullet,	pdMuzzlePlasma,	pdMuzzleRocket,	pdPlasma,		pdElectric;
-			OBParticleData pdSmoke,			pdShard,		pdCharge,		pdHeal,			pdForceField;
-			OBParticleData pdCaseBullet,	pdCaseRocket;
+			// Particle presets (indices in the preset table)
+			std::size_t pdBloodRed,		pdGibRed,		pdExplosion,	pdDebris,		pdDebrisFloor;
+			std::size_t pdMuzzleBullet,	pdMuzzlePlasma,	pdMuzzleRocket,	pdPlasma,		pdElectric;
+			std::size_t pdSmoke,		pdShard,		pdCharge,		pdHeal,			pdForceField;
+			std::size_t pdCaseBullet,	pdCaseRocket;
 
 			#define WALLTSDECL(x)	sf::IntRect x ## Single,	x ## Cross,		x ## V,			x ## H, \
 												x ## CornerSW,	x ## CornerSE,	x ## CornerNW,	x ## CornerNE, \
@@ -176,24 +184,24 @@ namespace ob
 				ssvuj::Obj jABulletBooster{ssvuj::getFromFile("Data/Animations/bulletBooster.json")};
 				aBulletBooster = ssvs::getAnimationFromJson(*tsSmall, jABulletBooster["on"]);
 
-				// Particle data
-				pdBloodRed =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/bloodRed.json"));
-				pdGibRed =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/gibRed.json"));
-				pdExplosion =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/explosion.json"));
-				pdDebris =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/debris.json"));
-				pdDebrisFloor =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/debrisFloor.json"));
-				pdMuzzleBullet =	ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/muzzleBullet.json"));
-				pdMuzzlePlasma =	ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/muzzlePlasma.json"));
-				pdMuzzleRocket =	ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/muzzleRocket.json"));
-				pdPlasma =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/plasma.json"));
-				pdElectric =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/electric.json"));
-				pdSmoke =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/smoke.json"));
-				pdShard =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/shard.json"));
-				pdCharge =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/charge.json"));
-				pdHeal =			ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/heal.json"));
-				pdForceField =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/forceField.json"));
-				pdCaseBullet =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/caseBullet.json"));
-				pdCaseRocket =		ssvuj::getExtr<OBParticleData>(ssvuj::getFromFile("Data/Particles/caseRocket.json"));
+				// Particle presets, invalid data is rejected here
+				pdBloodRed =		loadParticlePreset("bloodRed", OBParticleTarget::Perm);
+				pdGibRed =			loadParticlePreset("gibRed", OBParticleTarget::Temp);
+				pdExplosion =		loadParticlePreset("explosion", OBParticleTarget::TempAdd);
+				pdDebris =			loadParticlePreset("debris", OBParticleTarget::Temp);
+				pdDebrisFloor =		loadParticlePreset("debrisFloor", OBParticleTarget::Temp);
+				pdMuzzleBullet =	loadParticlePreset("muzzleBullet", OBParticleTarget::TempAdd);
+				pdMuzzlePlasma =	loadParticlePreset("muzzlePlasma", OBParticleTarget::TempAdd);
+				pdMuzzleRocket =	loadParticlePreset("muzzleRocket", OBParticleTarget::TempAdd);
+				pdPlasma =			loadParticlePreset("plasma", OBParticleTarget::TempAdd);
+				pdElectric =		loadParticlePreset("electric", OBParticleTarget::TempAdd);
+				pdSmoke =			loadParticlePreset("smoke", OBParticleTarget::Temp);
+				pdShard =			loadParticlePreset("shard", OBParticleTarget::TempAdd);
+				pdCharge =			loadParticlePreset("charge", OBParticleTarget::TempAdd);
+				pdHeal =			loadParticlePreset("heal", OBParticleTarget::TempAdd);
+				pdForceField =		loadParticlePreset("forceField", OBParticleTarget::TempAdd);
+				pdCaseBullet =		loadParticlePreset("caseBullet", OBParticleTarget::Temp);
+				pdCaseRocket =		loadParticlePreset("caseRocket", OBParticleTarget::Temp);
 
 				#undef T_TSSMALL
 				#undef T_TSMEDIUM
@@ -218,6 +226,8 @@ namespace ob
 				musicPlayer.setLoop(true);
 			}
 
+			inline const OBParticlePreset& getParticlePreset(std::size_t mIdx) const noexcept { return particlePresets[mIdx]; }
+
 			inline const sf::IntRect& getFloorVariant() const noexcept		{ return ssvu::getRnd(0, 10) < 9 ? floor : (ssvu::getRnd(0, 2) < 1 ? floorAlt1 : floorAlt2); }
 			inline const sf::IntRect& getFloorGrateVariant() const noexcept	{ return ssvu::getRnd(0, 10) < 9 ? floorGrate : (ssvu::getRnd(0, 2) < 1 ? floorGrateAlt1 : floorGrateAlt2); }
 	};
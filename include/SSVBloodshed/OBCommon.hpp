@@ -106,8 +106,6 @@ namespace ob
 		GPPlate,
 		GTrapdoor,
 		GPlayer,
-		GShard,
-		GLevelBound,
 		GPit,
 		GKillable,
 		GEnvDestructible,
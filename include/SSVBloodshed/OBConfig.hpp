@@ -25,6 +25,8 @@ namespace ob
 			// GFX
 			float particleMult{1.f};
 			std::size_t particleMax{10000};
+			bool particleBudget{true};		// Scale particle counts at runtime to hold `particleBudgetMs`
+			float particleBudgetMs{12.f};	// Target update+draw time per frame, in milliseconds
 
 			// Input
 			Trigger tLeft, tRight, tUp, tDown;	// Movement triggers
@@ -75,6 +77,12 @@ namespace ob
 			inline static float getParticleMult() noexcept					{ return get().particleMult; }
 			inline static std::size_t getParticleMax() noexcept				{ return get().particleMax; }
 
+			inline static void setParticleBudgetEnabled(bool mValue) noexcept	{ get().particleBudget = mValue; }
+			inline static void setParticleBudgetMs(float mValue) noexcept		{ get().particleBudgetMs = mValue; }
+
+			inline static bool isParticleBudgetEnabled() noexcept				{ return get().particleBudget; }
+			inline static float getParticleBudgetMs() noexcept					{ return get().particleBudgetMs; }
+
 
 
 			// Input
@@ -104,7 +112,9 @@ namespace ssvuj
 
 		ssvuj::convertObj(gfx,
 				SSVUJ_CNV_OBJ_AUTO(mValue, particleMult),
-				SSVUJ_CNV_OBJ_AUTO(mValue, particleMax));
+				SSVUJ_CNV_OBJ_AUTO(mValue, particleMax),
+				SSVUJ_CNV_OBJ_AUTO(mValue, particleBudget),
+				SSVUJ_CNV_OBJ_AUTO(mValue, particleBudgetMs));
 
 		ssvuj::convertObj(sfx,
 				SSVUJ_CNV_OBJ_AUTO(mValue, soundEnabled),
@@ -6,6 +6,7 @@
 #define SSVOB_FACTORY
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBRng.hpp"
 
 namespace ob
 {
@@ -28,6 +29,7 @@ namespace ob
 			OBAssets& assets;
 			OBGame& game;
 			sses::Manager& manager;
+			OBRng rng;
 
 			sf::Sprite getSpriteByTile(const std::string& mTextureId, const sf::IntRect& mRect) const;
 			void emplaceSpriteByTile(OBCDraw& mCDraw, sf::Texture* mTexture, const sf::IntRect& mRect) const;
@@ -42,13 +44,16 @@ namespace ob
 		public:
 			OBFactory(OBAssets& mAssets, OBGame& mGame, sses::Manager& mManager) : assets(mAssets), game(mGame), manager(mManager) { }
 
+			inline OBRng& getRng() noexcept { return rng; }
+
 			Entity& createParticleSystem(sf::RenderTexture& mRenderTexture, bool mClearOnDraw = false, unsigned char mOpacity = 255, int mDrawPriority = 1000, sf::BlendMode mBlendMode = sf::BlendMode::BlendAlpha);
-			Entity& createTrail(const Vec2i& mA, const Vec2i& mB, const sf::Color& mColor);
+			Entity& createTrail(const Vec2i& mA, const std::vector<Vec2i>& mBs, const sf::Color& mColor);
+			Entity& createDrawable(const sf::Drawable& mDrawable, int mDrawPriority, sf::BlendMode mBlendMode = sf::BlendMode::BlendAlpha);
 
 			Entity& createFloor(const Vec2i& mPos, bool mGrate = false);
 			Entity& createPit(const Vec2i& mPos);
 			Entity& createTrapdoor(const Vec2i& mPos, bool mPlayerOnly);
-			Entity& createWall(const Vec2i& mPos, const sf::IntRect& mIntRect);
+			void createWall(const Vec2i& mPos, const sf::IntRect& mIntRect); // Plain walls have no entity, they are cells of the game's OBTileLayer
 			Entity& createWallDestructible(const Vec2i& mPos, const sf::IntRect& mIntRect);
 			Entity& createDoor(const Vec2i& mPos, const sf::IntRect& mIntRect, int mId, bool mOpen);
 			Entity& createDoorG(const Vec2i& mPos, const sf::IntRect& mIntRect, bool mOpen);
@@ -56,7 +61,6 @@ namespace ob
 			Entity& createPPlate(const Vec2i& mPos, int mId, PPlateType mType, IdAction mIdAction, bool mPlayerOnly);
 			Entity& createPlayer(const Vec2i& mPos);
 			Entity& createExplosiveCrate(const Vec2i& mPos, int mId);
-			Entity& createShard(const Vec2i& mPos);
 			Entity& createSpawner(const Vec2i& mPos, SpawnerItem mType, int mId, float mDelayStart = 0.f, float mDelaySpawn = 200.f, int mSpawnCount = 1);
 			Entity& createForceField(const Vec2i& mPos, int mId, Dir8 mDir, bool mBlockFriendly, bool mBlockEnemy, float mForceMult);
 			Entity& createBulletForceField(const Vec2i& mPos, int mId, Dir8 mDir, bool mBlockFriendly, bool mBlockEnemy);
@@ -34,6 +34,7 @@ namespace ob
 					<< "Bodies(all): "		<< bodies.size() << "\n"
 					<< "Bodies(static): "	<< bodies.size() - dynamicBodiesCount << "\n"
 					<< "Bodies(dynamic): "	<< dynamicBodiesCount << "\n"
+					<< "Tiles(static): "	<< game.tileLayer.getWallCount() << "\n"
 					<< "Sensors: "			<< sensors.size() << "\n"
 					<< "Entities: "			<< entities.size() << "\n"
 					<< "Components: "		<< componentCount << std::endl;
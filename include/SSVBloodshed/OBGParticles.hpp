@@ -6,8 +6,11 @@
 #define SSVOB_GAME_PARTICLES
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/CESystem/ThreadPool.hpp"
 #include "SSVBloodshed/OBFactory.hpp"
 #include "SSVBloodshed/Components/OBCParticleSystem.hpp"
+#include "SSVBloodshed/Particles/OBParticleBudget.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
 
 namespace ob
 {
@@ -21,8 +24,28 @@ namespace ob
 			OBParticleSystem* psTemp{nullptr};
 			OBParticleSystem* psTempAdd{nullptr};
 
+			// Emissions requested during an update are merged by system and parameters, then emitted in one batch each
+			struct Emission
+			{
+				OBParticleSystem* ps; const OBParticlePreset* preset;
+				std::size_t count; float rad, mult, distMult;
+				std::vector<Vec2f> positions;
+
+				inline bool matches(const OBParticleSystem* mPS, const OBParticlePreset* mPreset, std::size_t mCount, float mRad, float mMult, float mDistMult) const noexcept
+				{
+					return ps == mPS && preset == mPreset && count == mCount && rad == mRad && mult == mMult && distMult == mDistMult;
+				}
+			};
+			std::vector<Emission> pending;
+			OBParticleBudget budget;
+			const OBTileLayer& tileLayer;
+
+			// The particle systems share no mutable state, so each one is updated as a separate job
+			// Two workers are enough, as the calling thread runs jobs too while waiting
+			ssvces::ThreadPool pool{std::min<std::size_t>(2, ssvces::ThreadPool::getDefaultThreadCount())};
+
 		public:
-			inline OBGParticles()
+			inline OBGParticles(const OBTileLayer& mTileLayer) : tileLayer(mTileLayer)
 			{
 				txPSPerm.create(txWidth, txHeight);
 				txPSTemp.create(txWidth, txHeight);
@@ -30,11 +53,50 @@ namespace ob
 
 			inline void clear(OBFactory& mFactory)
 			{
+				pending.clear();
 				psPerm =	&mFactory.createParticleSystem(txPSPerm, false, 175, OBLayer::LPSPerm).getComponent<OBCParticleSystem>().getParticleSystem();
 				psTemp =	&mFactory.createParticleSystem(txPSTemp, true, 255, OBLayer::LPSTemp).getComponent<OBCParticleSystem>().getParticleSystem();
 				psTempAdd =	&mFactory.createParticleSystem(txPSTemp, true, 255, OBLayer::LPSTemp, sf::BlendMode::BlendAdd).getComponent<OBCParticleSystem>().getParticleSystem();
+
+				// Blood stops at walls, gibs and debris bounce off them, additive glows ignore them
+				psPerm->setCollisionLayer(&tileLayer, 0.f);
+				psTemp->setCollisionLayer(&tileLayer, 0.4f);
+			}
+
+			inline void emit(OBParticleSystem& mPS, std::size_t mCount, const Vec2f& mPos, const OBParticlePreset& mPreset, float mRad, float mMult, float mDistMult)
+			{
+				if(mCount == 0) return;
+
+				for(auto& e : pending) if(e.matches(&mPS, &mPreset, mCount, mRad, mMult, mDistMult)) { e.positions.emplace_back(mPos); return; }
+				pending.emplace_back(Emission{&mPS, &mPreset, mCount, mRad, mMult, mDistMult, {mPos}});
+			}
+			inline void flush()
+			{
+				for(auto ps : {psPerm, psTemp, psTempAdd}) if(ps != nullptr) ps->setBudgetScale(budget.getScale(ps == psPerm));
+
+				for(auto& e : pending)
+				{
+					auto count(e.ps->getBudgeted(e.count * e.positions.size()));
+					e.ps->emit(*e.preset, e.positions.data(), e.positions.size(), count, e.rad, e.mult, e.distMult);
+				}
+				pending.clear();
 			}
 
+			// Updates all particle systems in parallel and returns once their vertices are ready to be drawn
+			inline void update(FT mFT)
+			{
+				for(auto ps : {psPerm, psTemp, psTempAdd}) if(ps != nullptr) pool.push([ps, mFT]{ ps->update(mFT); });
+				pool.wait();
+			}
+
+			// Feeds the measured update+draw time of a frame to the budget controller
+			inline void addFrameTime(float mMs) noexcept { budget.addFrameTime(mMs); }
+
+			inline OBParticleSystem& getPS(OBParticleTarget mTarget) noexcept
+			{
+				if(mTarget == OBParticleTarget::Perm) return *psPerm;
+				return mTarget == OBParticleTarget::Temp ? *psTemp : *psTempAdd;
+			}
 			inline OBParticleSystem& getPSPerm() noexcept		{ return *psPerm; }
 			inline OBParticleSystem& getPSTemp() noexcept		{ return *psTemp; }
 			inline OBParticleSystem& getPSTempAdd() noexcept	{ return *psTempAdd; }
@@ -0,0 +1,241 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_SHARDS
+#define SSVOB_GAME_SHARDS
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBRng.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
+
+namespace ob
+{
+	class OBGShards : public sf::Drawable
+	{
+		// Pool of the shards dropped by killed enemies, without entities or physics bodies
+		// Shards bounce off the static tile layer and off solid bodies (doors, destructible walls, turrets...), which are gathered once per update
+		// Shards and solid bodies are indexed by spatial hashes with one bucket per level cell, all shards are drawn as a single additive vertex batch
+
+		private:
+			static constexpr int halfSize{200};
+			static constexpr float restitution{0.8f};
+
+			struct Shard { Vec2f pos, vel, accel; float deg; bool attracted, alive; };
+			struct Blocker { int left, right, top, bottom; };
+
+			const OBTileLayer& tileLayer;
+			World& world;
+			OBRng& rng;
+			sf::Texture& texture;
+			sf::IntRect rect;
+			std::vector<Shard> shards;
+			std::vector<sf::Vertex> vertices;
+
+			// Counting sort of the shard indices by cell: the shards of cell `i` are `indices[cellStart[i]]` up to `indices[cellStart[i + 1]]`
+			std::vector<std::size_t> cellStart, indices;
+
+			// Same layout for the solid bodies, each one listed in every cell it overlaps
+			// Rebuilt at most once per update, and only when a shard not stopped by the tiles asks for it
+			std::vector<Blocker> blockers;
+			std::vector<std::size_t> blockerStart, blockerIndices;
+			bool blockersValid{false};
+
+			inline static int getCellX(float mX) noexcept { return ssvu::getClamped(OBTileLayer::getCell(mX), 0, levelCols - 1); }
+			inline static int getCellY(float mY) noexcept { return ssvu::getClamped(OBTileLayer::getCell(mY), 0, levelRows - 1); }
+			inline static int getCellIdx(const Vec2f& mPos) noexcept { return getCellY(mPos.y) * levelCols + getCellX(mPos.x); }
+
+			// Calls `mFn` with every pair of cell coordinates overlapped by the box, clamped to the level
+			template<typename TF> inline static void forCells(float mLeft, float mRight, float mTop, float mBottom, const TF& mFn)
+			{
+				for(int y{getCellY(mTop)}, y1{getCellY(mBottom)}; y <= y1; ++y)
+					for(int x{getCellX(mLeft)}, x1{getCellX(mRight)}; x <= x1; ++x) mFn(y * levelCols + x);
+			}
+
+			inline bool isBlocked(float mX, float mY)
+			{
+				if(tileLayer.isSolid(OBTileLayer::getCell(mX - halfSize), OBTileLayer::getCell(mY - halfSize))
+					|| tileLayer.isSolid(OBTileLayer::getCell(mX + halfSize - 1), OBTileLayer::getCell(mY - halfSize))
+					|| tileLayer.isSolid(OBTileLayer::getCell(mX - halfSize), OBTileLayer::getCell(mY + halfSize - 1))
+					|| tileLayer.isSolid(OBTileLayer::getCell(mX + halfSize - 1), OBTileLayer::getCell(mY + halfSize - 1))) return true;
+
+				if(!blockersValid) rebuildBlockers();
+
+				bool result{false};
+				forCells(mX - halfSize, mX + halfSize - 1, mY - halfSize, mY + halfSize - 1, [&](int mCell)
+				{
+					for(auto i(blockerStart[mCell]); !result && i < blockerStart[mCell + 1]; ++i)
+					{
+						const auto& b(blockers[blockerIndices[i]]);
+						result = mX + halfSize > b.left && mX - halfSize < b.right && mY + halfSize > b.top && mY - halfSize < b.bottom;
+					}
+				});
+				return result;
+			}
+
+			// Gathers the bodies shards should bounce off: solid ground that is neither organic (shards are picked up or pass over them) nor a pit
+			inline void rebuildBlockers()
+			{
+				blockersValid = true;
+				blockers.clear();
+				for(const auto& b : world.getBodies())
+				{
+					const Body& body(*b);
+					if(!body.hasGroup(OBGroup::GSolidGround) || body.hasGroup(OBGroup::GOrganic) || body.hasGroup(OBGroup::GPit)) continue;
+					const auto& s(body.getShape());
+					blockers.push_back({s.getLeft(), s.getRight(), s.getTop(), s.getBottom()});
+				}
+
+				blockerStart.assign(levelCols * levelRows + 1, 0);
+				for(const auto& b : blockers) forCells(b.left, b.right - 1, b.top, b.bottom - 1, [this](int mCell){ ++blockerStart[mCell + 1]; });
+				for(auto i(1u); i < blockerStart.size(); ++i) blockerStart[i] += blockerStart[i - 1];
+
+				blockerIndices.resize(blockerStart.back());
+				auto next(blockerStart);
+				for(auto i(0u); i < blockers.size(); ++i)
+				{
+					const auto& b(blockers[i]);
+					forCells(b.left, b.right - 1, b.top, b.bottom - 1, [&](int mCell){ blockerIndices[next[mCell]++] = i; });
+				}
+			}
+
+			inline void move(Shard& mShard, FT mFT)
+			{
+				// Attracted shards fly through walls towards the player, the others move one axis at a time and bounce back when blocked
+				Vec2f next{mShard.pos + mShard.vel * mFT};
+				if(mShard.attracted) { mShard.pos = next; return; }
+
+				if(isBlocked(next.x, mShard.pos.y)) mShard.vel.x *= -restitution; else mShard.pos.x = next.x;
+				if(isBlocked(mShard.pos.x, next.y)) mShard.vel.y *= -restitution; else mShard.pos.y = next.y;
+			}
+
+			inline void rebuildIndex()
+			{
+				cellStart.assign(levelCols * levelRows + 1, 0);
+				for(const auto& s : shards) ++cellStart[getCellIdx(s.pos) + 1];
+				for(auto i(1u); i < cellStart.size(); ++i) cellStart[i] += cellStart[i - 1];
+
+				indices.resize(shards.size());
+				auto next(cellStart);
+				for(auto i(0u); i < shards.size(); ++i) indices[next[getCellIdx(shards[i].pos)]++] = i;
+			}
+
+			inline void refreshVertices()
+			{
+				vertices.resize(shards.size() * 4);
+				const float half{tileSize * 0.65f / 2.f};
+				const float tl(rect.left), tt(rect.top), tr(tl + rect.width), tb(tt + rect.height);
+
+				for(auto i(0u); i < shards.size(); ++i)
+				{
+					const auto& s(shards[i]);
+					Vec2f center{toPixels(s.pos)}, x{ssvs::getVecFromDeg(s.deg, half)}, y{-x.y, x.x};
+					auto v(&vertices[i * 4]);
+					v[0].position = center - x - y; v[0].texCoords = {tl, tt};
+					v[1].position = center + x - y; v[1].texCoords = {tr, tt};
+					v[2].position = center + x + y; v[2].texCoords = {tr, tb};
+					v[3].position = center - x + y; v[3].texCoords = {tl, tb};
+				}
+			}
+
+			// Calls `mFn` with the index of every indexed shard still alive in the cells overlapping the square of half-size `mRadius` around `mPos`
+			template<typename TF> inline void forNearby(const Vec2f& mPos, float mRadius, const TF& mFn) const
+			{
+				if(cellStart.empty()) return;
+				forCells(mPos.x - mRadius, mPos.x + mRadius, mPos.y - mRadius, mPos.y + mRadius, [&](int mCell)
+				{
+					for(auto i(cellStart[mCell]); i < cellStart[mCell + 1]; ++i) if(shards[indices[i]].alive) mFn(indices[i]);
+				});
+			}
+
+		public:
+			inline OBGShards(const OBTileLayer& mTileLayer, World& mWorld, OBRng& mRng, sf::Texture& mTexture, const sf::IntRect& mRect)
+				: tileLayer(mTileLayer), world(mWorld), rng(mRng), texture(mTexture), rect(mRect) { }
+
+			inline void clear() { shards.clear(); vertices.clear(); cellStart.clear(); indices.clear(); blockers.clear(); blockerStart.clear(); blockerIndices.clear(); blockersValid = false; }
+
+			// `mPos` is in coords, shards are thrown in random directions
+			inline void emit(std::size_t mCount, const Vec2i& mPos)
+			{
+				for(auto i(0u); i < mCount; ++i)
+					shards.push_back({Vec2f(mPos), ssvs::getVecFromRad(rng.getRndR(0.f, ssvu::tau), rng.getRndR(100.f, 370.f)), ssvs::zeroVec2f, float(rng.getRnd(0, 360)), false, true});
+			}
+
+			inline void update(FT mFT)
+			{
+				// Collected shards are swap-removed before the index is rebuilt
+				for(auto i(0u); i < shards.size();)
+				{
+					if(shards[i].alive) { ++i; continue; }
+					shards[i] = shards.back(); shards.pop_back();
+				}
+
+				if(shards.empty()) { vertices.clear(); cellStart.clear(); indices.clear(); return; }
+				blockersValid = false;
+
+				for(auto& s : shards)
+				{
+					s.vel = ssvs::getCClampedMax(s.vel * 0.99f, 500.f);
+					s.vel += s.accel * mFT; s.accel = ssvs::zeroVec2f;
+					move(s, mFT);
+					s.deg += ssvs::getMag(s.vel) * 0.01f;
+				}
+
+				rebuildIndex();
+				refreshVertices();
+			}
+
+			// Pulls shards within `mRadius` towards `mTarget`, proportionally to their distance
+			inline void attract(const Vec2f& mTarget, float mRadius, float mMult)
+			{
+				forNearby(mTarget, mRadius, [&](std::size_t mIdx)
+				{
+					auto& s(shards[mIdx]);
+					if(ssvs::getDistEuclidean(s.pos, mTarget) <= mRadius) s.accel += (mTarget - s.pos) * mMult;
+				});
+			}
+
+			// Once the level is clear every shard flies through walls towards `mTarget`
+			inline void vacuum(const Vec2f& mTarget)
+			{
+				for(auto& s : shards)
+				{
+					if(!s.alive) continue;
+					s.attracted = true;
+					if(ssvs::getDistEuclidean(s.pos, mTarget) > 6500)
+					{
+						if(ssvs::getMag(s.vel) < 650.f) s.accel += (mTarget - s.pos) * 0.002f;
+					}
+					else s.vel = ssvs::getMClampedMax((mTarget - s.pos) / 1.5f, 400.f);
+				}
+			}
+
+			// Removes the shards overlapping the box centered on `mPos` and calls `mFn` with each one's position in pixels
+			// Collected shards are skipped by later queries and their quads are collapsed right away, they are compacted on the next update
+			// Returns the number of collected shards
+			template<typename TF> inline int collect(const Vec2f& mPos, const Vec2f& mHalfSize, const TF& mFn)
+			{
+				int result{0};
+				forNearby(mPos, std::max(mHalfSize.x, mHalfSize.y) + halfSize, [&](std::size_t mIdx)
+				{
+					auto& s(shards[mIdx]);
+					if(std::abs(s.pos.x - mPos.x) >= mHalfSize.x + halfSize || std::abs(s.pos.y - mPos.y) >= mHalfSize.y + halfSize) return;
+					s.alive = false; ++result;
+					if(mIdx * 4 < vertices.size()) { auto v(&vertices[mIdx * 4]); v[1].position = v[2].position = v[3].position = v[0].position; }
+					mFn(toPixels(s.pos));
+				});
+				return result;
+			}
+
+			inline void draw(sf::RenderTarget& mRenderTarget, sf::RenderStates mRenderStates) const override
+			{
+				if(vertices.empty()) return;
+				mRenderStates.texture = &texture;
+				mRenderTarget.draw(&vertices[0], vertices.size(), sf::PrimitiveType::Quads, mRenderStates);
+			}
+
+			inline std::size_t getCount() const noexcept { return shards.size(); }
+	};
+}
+
+#endif
@@ -5,12 +5,18 @@
 #ifndef SSVOB_GAME
 #define SSVOB_GAME
 
+#include <chrono>
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBAssets.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
 #include "SSVBloodshed/OBFactory.hpp"
 #include "SSVBloodshed/OBGDebugText.hpp"
 #include "SSVBloodshed/OBGParticles.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
+#include "SSVBloodshed/OBLineOfSight.hpp"
+#include "SSVBloodshed/OBGShards.hpp"
+#include "SSVBloodshed/OBIdRouter.hpp"
+#include "SSVBloodshed/OBTargetIndex.hpp"
 #include "SSVBloodshed/OBGInput.hpp"
 #include "SSVBloodshed/OBBarCounter.hpp"
 #include "SSVBloodshed/OBSharedData.hpp"
@@ -43,10 +49,16 @@ namespace ob
 			ssvs::Camera gameCamera{gameWindow, 2.f}, overlayCamera{gameWindow, 2.f};
 			OBFactory factory{assets, *this, manager};
 			World world{1000, 1000, 1000, 500};
+			OBIdRouter idRouter; // Declared before the manager, as id receivers and plates unregister on destruction
+			OBTargetIndex targetIndex; // Declared before the manager, as targets unregister on destruction
 			sses::Manager manager;
+			OBTileLayer tileLayer{*assets.txSmall}; // Plain walls and level bounds, not part of the world's HashGrid
+			OBLineOfSight lineOfSight{tileLayer};
+			OBGShards shards{tileLayer, world, factory.getRng(), *assets.txSmall, assets.shard};
 
 			OBGInput<OBGame> input{*this};
-			OBGParticles particles;
+			OBGParticles particles{tileLayer};
+			float frameMs{0.f}; // Time spent in update() since the last draw(), fed to the particle budget
 
 			OBGDebugText<OBGame> debugText{*this};
 			sf::Sprite hudSprite{assets.get<sf::Texture>("tempHud.png")};
@@ -63,25 +75,15 @@ namespace ob
 			GUI::Context guiCtx{assets, gameWindow, GUI::Style{*assets.obBigStroked}};
 			FormIO* formIO{nullptr};
 
-			inline void createParticles(OBParticleSystem& mPS, std::size_t mCount, const Vec2f& mPos, OBParticleData& mData, float mRad = 0.f, float mMult = 1.f, float mDistMult = 1.f)
+			// Particles are queued and emitted in batches at the end of the update, see OBGParticles
+			// `mPreset` is an index in the assets' preset table, particles go to the preset's target system unless another one is given
+			inline void createParticles(OBParticleTarget mTarget, std::size_t mPreset, std::size_t mCount, const Vec2f& mPos, float mRad = 0.f, float mMult = 1.f, float mDistMult = 1.f)
 			{
-				auto total(mCount * OBConfig::getParticleMult());
-				for(auto i(0u); i < total; ++i)
-				{
-					float rad(mRad + getRndRngF(mData.angleRng));
-
-					mPS.emplace(
-						ssvs::getOrbitRad(mPos, rad, getRndRngF(mData.distRng) * mDistMult),		// Position
-						ssvs::getVecFromRad(rad, getRndRngF(mData.velRng) * mMult),					// Velocity
-						getRndRngF(mData.sizeRng),													// Size
-						getRndRngF(mData.lifeRng),													// Life
-						getRndRngF(mData.curveSpdRng),												// Curve speed
-						getRndRngF(mData.fuzzinessRng),												// Fuzziness
-						getRndRngF(mData.accelRng),													// Acceleration
-						mData.alphaMult,															// Alpha multiplier
-						getColorFromRng(mData.colorRngs[ssvu::getRnd(0ul, mData.colorRngs.size())])	// Color
-					);
-				}
+				particles.emit(particles.getPS(mTarget), std::ceil(mCount * OBConfig::getParticleMult()), mPos, assets.getParticlePreset(mPreset), mRad, mMult, mDistMult);
+			}
+			inline void createParticles(std::size_t mPreset, std::size_t mCount, const Vec2f& mPos, float mRad = 0.f, float mMult = 1.f, float mDistMult = 1.f)
+			{
+				createParticles(assets.getParticlePreset(mPreset).target, mPreset, mCount, mPos, mRad, mMult, mDistMult);
 			}
 
 		public:
@@ -143,33 +145,18 @@ namespace ob
 				loadCurrentLevel();
 			}
 
-			inline void createBounds()
-			{
-				int width{levelWidthCoords}, height{levelHeightCoords}, offset{toCoords(100)};
-
-				std::initializer_list<std::pair<Vec2i, Vec2i>> bounds
-				{
-					{{0 - offset, 0},	{0, height}},
-					{{width, 0},		{width + offset, height}},
-					{{0, 0 - offset},	{width, 0}},
-					{{0, height},		{width, height + offset}}
-				};
-
-				for(const auto& p : bounds) world.create(ssvs::getCenter(p.first, p.second), ssvs::getSize(p.first, p.second), true).addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir, OBGroup::GLevelBound);
-			}
-
 			inline void loadCurrentLevel()
 			{
 				auto getTilePos = [](int mX, int mY){ return toCoords(Vec2i{mX * 10 + 5, mY * 10 + 5}); };
-				manager.clear(); world.clear(); particles.clear(factory);
+				manager.clear(); world.clear(); idRouter.clear(); targetIndex.clear(); tileLayer.clear(); shards.clear(); particles.clear(factory);
+				factory.createDrawable(tileLayer, OBLayer::LWall);
+				factory.createDrawable(shards, OBLayer::LShard, sf::BlendMode::BlendAdd);
 
 				try
 				{
 					for(auto& p : sharedData.getCurrentTiles()) sharedData.getDatabase().spawn(sharedData.getCurrentLevel(), p.second, getTilePos(p.second.getX(), p.second.getY()));
 				}
 				catch(...) { ssvu::lo("Fatal error") << "Failed to load level" << std::endl; }
-
-				createBounds();
 			}
 
 			template<typename TPlayer> inline bool changeLevel(const TPlayer& mPlayer, int mDirX, int mDirY)
@@ -208,12 +195,24 @@ namespace ob
 			inline bool isLevelClear() noexcept		{ return manager.getEntityCount(OBGroup::GEnemy) <= 0; }
 			inline void updateLevelStat() noexcept	{ if(isLevelClear()) levelStats[&sharedData.getCurrentLevel()].clear = true; }
 
+			inline static float getMsSince(const std::chrono::high_resolution_clock::time_point& mStart) noexcept
+			{
+				return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - mStart).count();
+			}
+
 			inline void update(FT mFT)
 			{
+				auto start(std::chrono::high_resolution_clock::now());
+
 				if(!paused && !sharedData.isCurrentLevelNull())
 				{
+					lineOfSight.newFrame();
+					targetIndex.newFrame();
 					manager.update(mFT);
 					world.update(mFT);
+					shards.update(mFT);
+					particles.flush();
+					particles.update(mFT);
 				}
 				else
 				{
@@ -231,9 +230,12 @@ namespace ob
 				}
 
 				testAmmoTxt.setString(ssvu::toStr(testhp.getValue()));
+				frameMs += getMsSince(start);
 			}
 			inline void draw()
 			{
+				auto start(std::chrono::high_resolution_clock::now());
+
 				//TODO: canc in textbox
 				gameCamera.apply<int>();
 				manager.draw();
@@ -254,6 +256,9 @@ namespace ob
 				if(paused) guiCtx.draw();
 
 				debugText.draw();
+
+				if(!paused) particles.addFrameTime(frameMs + getMsSince(start));
+				frameMs = 0.f;
 			}
 
 			template<typename... TArgs> inline void render(const sf::Drawable& mDrawable, TArgs&&... mArgs)	{ gameWindow.draw(mDrawable, std::forward<TArgs>(mArgs)...); }
@@ -267,36 +272,41 @@ namespace ob
 			inline OBFactory& getFactory() noexcept						{ return factory; }
 			inline ssvs::GameState& getGameState() noexcept				{ return gameState; }
 			inline World& getWorld() noexcept							{ return world; }
+			inline OBTileLayer& getTileLayer() noexcept					{ return tileLayer; }
+			inline OBLineOfSight& getLineOfSight() noexcept				{ return lineOfSight; }
+			inline OBGShards& getShards() noexcept						{ return shards; }
+			inline OBIdRouter& getIdRouter() noexcept					{ return idRouter; }
+			inline OBTargetIndex& getTargetIndex() noexcept				{ return targetIndex; }
 			inline sses::Manager& getManager() noexcept					{ return manager; }
 			inline const decltype(input)& getInput() const noexcept		{ return input; }
 
 			inline void createPBlood(std::size_t mCount, const Vec2f& mPos, float mMult = 1.f)
 			{
-				createParticles(particles.getPSPerm(), mCount, mPos, assets.pdBloodRed, 0.f, mMult, 1.f);
-				createParticles(particles.getPSTemp(), mCount / 2, mPos, assets.pdGibRed, 0.f, mMult, 1.f);
+				createParticles(assets.pdBloodRed, mCount, mPos, 0.f, mMult, 1.f);
+				createParticles(assets.pdGibRed, mCount / 2, mPos, 0.f, mMult, 1.f);
 			}
 			inline void createPExplosion(std::size_t mCount, const Vec2f& mPos)
 			{
-				createParticles(particles.getPSTempAdd(), mCount, mPos, assets.pdExplosion);
-				createParticles(particles.getPSTemp(), mCount / 2, mPos, assets.pdExplosion);
+				createParticles(assets.pdExplosion, mCount, mPos);
+				createParticles(OBParticleTarget::Temp, assets.pdExplosion, mCount / 2, mPos);
 			}
-			inline void createPGib(std::size_t mCount, const Vec2f& mPos)						{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdGibRed); }
-			inline void createPDebris(std::size_t mCount, const Vec2f& mPos)					{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdDebris); }
-			inline void createPDebrisFloor(std::size_t mCount, const Vec2f& mPos)				{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdDebrisFloor); }
-			inline void createPMuzzleBullet(std::size_t mCount, const Vec2f& mPos)				{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdMuzzleBullet); }
-			inline void createPMuzzlePlasma(std::size_t mCount, const Vec2f& mPos)				{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdMuzzlePlasma); }
-			inline void createPMuzzleRocket(std::size_t mCount, const Vec2f& mPos)				{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdMuzzleRocket); }
-			inline void createPPlasma(std::size_t mCount, const Vec2f& mPos)					{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdPlasma); }
-			inline void createPSmoke(std::size_t mCount, const Vec2f& mPos)						{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdSmoke); }
-			inline void createPElectric(std::size_t mCount, const Vec2f& mPos)					{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdElectric); }
-			inline void createPCharge(std::size_t mCount, const Vec2f& mPos, float mDistMult)	{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdCharge, 0.f, 1.f, mDistMult); }
-			inline void createPShard(std::size_t mCount, const Vec2f& mPos)						{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdShard); }
-			inline void createPHeal(std::size_t mCount, const Vec2f& mPos)						{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdHeal); }
-			inline void createPCaseBullet(std::size_t mCount, const Vec2f& mPos, float mDeg)	{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdCaseBullet, ssvu::toRad(mDeg + 90), 1.f, 1.f); }
-			inline void createPCaseRocket(std::size_t mCount, const Vec2f& mPos, float mDeg)	{ createParticles(particles.getPSTemp(),	mCount, mPos, assets.pdCaseRocket, ssvu::toRad(mDeg + 90), 1.f, 1.f); }
-			inline void createPForceField(std::size_t mCount, const Vec2f& mPos)				{ createParticles(particles.getPSTempAdd(),	mCount, mPos, assets.pdForceField); }
-
-			inline void createEShard(std::size_t mCount, const Vec2i& mPos) { for(auto i(0u); i < mCount; ++i) factory.createShard(mPos); }
+			inline void createPGib(std::size_t mCount, const Vec2f& mPos)						{ createParticles(assets.pdGibRed, mCount, mPos); }
+			inline void createPDebris(std::size_t mCount, const Vec2f& mPos)					{ createParticles(assets.pdDebris, mCount, mPos); }
+			inline void createPDebrisFloor(std::size_t mCount, const Vec2f& mPos)				{ createParticles(assets.pdDebrisFloor, mCount, mPos); }
+			inline void createPMuzzleBullet(std::size_t mCount, const Vec2f& mPos)				{ createParticles(assets.pdMuzzleBullet, mCount, mPos); }
+			inline void createPMuzzlePlasma(std::size_t mCount, const Vec2f& mPos)				{ createParticles(assets.pdMuzzlePlasma, mCount, mPos); }
+			inline void createPMuzzleRocket(std::size_t mCount, const Vec2f& mPos)				{ createParticles(assets.pdMuzzleRocket, mCount, mPos); }
+			inline void createPPlasma(std::size_t mCount, const Vec2f& mPos)					{ createParticles(assets.pdPlasma, mCount, mPos); }
+			inline void createPSmoke(std::size_t mCount, const Vec2f& mPos)						{ createParticles(assets.pdSmoke, mCount, mPos); }
+			inline void createPElectric(std::size_t mCount, const Vec2f& mPos)					{ createParticles(assets.pdElectric, mCount, mPos); }
+			inline void createPCharge(std::size_t mCount, const Vec2f& mPos, float mDistMult)	{ createParticles(assets.pdCharge, mCount, mPos, 0.f, 1.f, mDistMult); }
+			inline void createPShard(std::size_t mCount, const Vec2f& mPos)						{ createParticles(assets.pdShard, mCount, mPos); }
+			inline void createPHeal(std::size_t mCount, const Vec2f& mPos)						{ createParticles(assets.pdHeal, mCount, mPos); }
+			inline void createPCaseBullet(std::size_t mCount, const Vec2f& mPos, float mDeg)	{ createParticles(assets.pdCaseBullet, mCount, mPos, ssvu::toRad(mDeg + 90), 1.f, 1.f); }
+			inline void createPCaseRocket(std::size_t mCount, const Vec2f& mPos, float mDeg)	{ createParticles(assets.pdCaseRocket, mCount, mPos, ssvu::toRad(mDeg + 90), 1.f, 1.f); }
+			inline void createPForceField(std::size_t mCount, const Vec2f& mPos)				{ createParticles(assets.pdForceField, mCount, mPos); }
+
+			inline void createEShard(std::size_t mCount, const Vec2i& mPos) { shards.emit(mCount, mPos); }
 	};
 }
 
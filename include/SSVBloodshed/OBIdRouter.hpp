@@ -0,0 +1,67 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_IDROUTER
+#define SSVOB_IDROUTER
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
+
+namespace ob
+{
+	class OBCIdReceiver;
+	class OBCPPlate;
+
+	class OBIdRouter
+	{
+		// Routing table of the current level: receivers by id, and pressure plates by cell
+		// Replaces scanning the GIdReceiver group on every activation and Distance queries to find adjacent plates
+		// Components register themselves on init and unregister on destruction
+
+		private:
+			std::unordered_map<int, std::vector<OBCIdReceiver*>> receivers;
+			std::vector<OBCPPlate*> plates;
+			std::size_t platesVersion{0}; // Incremented when a plate is added or removed, lets plates know when to rebuild their clusters
+
+			inline static int getCellIdx(const Vec2i& mPos) noexcept
+			{
+				int x{OBTileLayer::getCell(mPos.x)}, y{OBTileLayer::getCell(mPos.y)};
+				return OBTileLayer::isInside(x, y) ? y * levelCols + x : -1;
+			}
+
+		public:
+			inline OBIdRouter() : plates(levelCols * levelRows, nullptr) { }
+
+			inline void clear() { receivers.clear(); std::fill(std::begin(plates), std::end(plates), nullptr); ++platesVersion; }
+
+			inline void addReceiver(int mId, OBCIdReceiver& mReceiver) { receivers[mId].push_back(&mReceiver); }
+			inline void delReceiver(int mId, OBCIdReceiver& mReceiver)
+			{
+				auto itr(receivers.find(mId));
+				if(itr != std::end(receivers)) ssvu::eraseRemove(itr->second, &mReceiver);
+			}
+
+			inline void addPlate(const Vec2i& mPos, OBCPPlate& mPlate)
+			{
+				auto idx(getCellIdx(mPos));
+				if(idx != -1) { plates[idx] = &mPlate; ++platesVersion; }
+			}
+			inline void delPlate(const Vec2i& mPos, OBCPPlate& mPlate)
+			{
+				auto idx(getCellIdx(mPos));
+				if(idx != -1 && plates[idx] == &mPlate) { plates[idx] = nullptr; ++platesVersion; }
+			}
+
+			inline const std::vector<OBCIdReceiver*>& getReceivers(int mId) const
+			{
+				static std::vector<OBCIdReceiver*> empty;
+				auto itr(receivers.find(mId));
+				return itr == std::end(receivers) ? empty : itr->second;
+			}
+			inline OBCPPlate* getPlate(int mX, int mY) const noexcept { return OBTileLayer::isInside(mX, mY) ? plates[mY * levelCols + mX] : nullptr; }
+			inline std::size_t getPlatesVersion() const noexcept { return platesVersion; }
+	};
+}
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LINEOFSIGHT
+#define SSVOB_LINEOFSIGHT
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
+
+namespace ob
+{
+	class OBLineOfSight
+	{
+		// Line of sight service shared by all enemies
+		// Static walls are answered by a cell-to-cell table over the OBTileLayer, filled on first use of every pair and reset when the layer changes
+		// Full answers (static walls plus the caller's dynamic check) are cached for the current frame per seeker cell, target and query flags
+
+		private:
+			static constexpr int cellCount{levelCols * levelRows};
+			static constexpr int cellCoords{toCoords(tileSize)};
+
+			struct Entry { int cell; const void* target; int flags; bool visible; };
+
+			const OBTileLayer& tileLayer;
+			std::size_t tileLayerVersion{0};
+			std::vector<bool> known, visible; // Indexed by unordered cell pair, see getPairIdx()
+			std::vector<Entry> frameCache;
+
+			inline static int getCellIdx(const Vec2i& mPos) noexcept
+			{
+				int x{OBTileLayer::getCell(mPos.x)}, y{OBTileLayer::getCell(mPos.y)};
+				return OBTileLayer::isInside(x, y) ? y * levelCols + x : -1;
+			}
+			inline static std::size_t getPairIdx(int mA, int mB) noexcept
+			{
+				if(mA > mB) std::swap(mA, mB);
+				return std::size_t(mA) * cellCount + mB;
+			}
+			inline static Vec2i getCellCenter(int mCell) noexcept
+			{
+				return {(mCell % levelCols) * cellCoords + cellCoords / 2, (mCell / levelCols) * cellCoords + cellCoords / 2};
+			}
+
+			inline void refresh()
+			{
+				if(tileLayerVersion == tileLayer.getVersion() && !known.empty()) return;
+				tileLayerVersion = tileLayer.getVersion();
+				known.assign(std::size_t(cellCount) * cellCount, false);
+				visible.assign(std::size_t(cellCount) * cellCount, false);
+				frameCache.clear();
+			}
+
+		public:
+			inline OBLineOfSight(const OBTileLayer& mTileLayer) noexcept : tileLayer(mTileLayer) { }
+
+			inline void newFrame() noexcept { frameCache.clear(); }
+
+			// Whether the centers of the cells containing `mA` and `mB` see each other through the static walls
+			inline bool isStaticVisible(const Vec2i& mA, const Vec2i& mB)
+			{
+				refresh();
+
+				int a{getCellIdx(mA)}, b{getCellIdx(mB)};
+				if(a == -1 || b == -1) return !tileLayer.isSegmentBlocked(mA, mB);
+
+				auto idx(getPairIdx(a, b));
+				if(!known[idx])
+				{
+					known[idx] = true;
+					visible[idx] = !tileLayer.isSegmentBlocked(getCellCenter(a), getCellCenter(b));
+				}
+				return visible[idx];
+			}
+
+			// Whether a seeker at `mSeeker` sees the target `mTarget` at `mTargetPos`
+			// `mDynamicCheck` handles everything that is not a static wall and only runs if the static table is clear
+			// Seekers in the same cell asking with the same target and `mFlags` during a frame share the first one's answer
+			template<typename TF> inline bool canSee(const Vec2i& mSeeker, const void* mTarget, const Vec2i& mTargetPos, int mFlags, const TF& mDynamicCheck)
+			{
+				refresh();
+
+				int cell{getCellIdx(mSeeker)};
+				if(cell != -1)
+					for(const auto& e : frameCache)
+						if(e.cell == cell && e.target == mTarget && e.flags == mFlags) return e.visible;
+
+				bool result{isStaticVisible(mSeeker, mTargetPos) && mDynamicCheck()};
+				if(cell != -1) frameCache.push_back({cell, mTarget, mFlags, result});
+				return result;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,56 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_RNG
+#define SSVOB_RNG
+
+#include <random>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+	class OBRng
+	{
+		// Small PCG32 generator meant to be owned by a single system (a particle system, the factory...)
+		// Much cheaper than going through ssvu's shared generator, and every owner can be seeded independently
+		// Ranges follow ssvu: `getRnd` and `getRndR` return values in [min, max)
+
+		private:
+			std::uint64_t state{0}, inc{0};
+
+		public:
+			inline OBRng() { seed(std::random_device{}()); }
+			inline OBRng(std::uint64_t mSeed, std::uint64_t mStream = 0) noexcept { seed(mSeed, mStream); }
+
+			inline void seed(std::uint64_t mSeed, std::uint64_t mStream = 0) noexcept
+			{
+				state = 0; inc = (mStream << 1u) | 1u;
+				next(); state += mSeed; next();
+			}
+
+			inline std::uint32_t next() noexcept
+			{
+				std::uint64_t old{state};
+				state = old * 6364136223846793005ull + inc;
+				auto xorShifted(std::uint32_t(((old >> 18u) ^ old) >> 27u));
+				auto rot(std::uint32_t(old >> 59u));
+				return (xorShifted >> rot) | (xorShifted << ((-rot) & 31u));
+			}
+
+			// Uniform float in [0, 1), built from the 24 high bits
+			inline float getRndUnit() noexcept { return (next() >> 8u) * (1.f / 16777216.f); }
+
+			template<typename T> inline T getRnd(T mMin, T mMax) noexcept { return mMin + T((std::uint64_t(next()) * std::uint64_t(mMax - mMin)) >> 32u); }
+			inline float getRndR(float mMin, float mMax) noexcept { return mMin + getRndUnit() * (mMax - mMin); }
+
+			// Bulk generation: fills `mCount` floats in [mMin, mMax) starting at `mOut`
+			inline void fill(float* mOut, std::size_t mCount, float mMin, float mMax) noexcept
+			{
+				const float scale{(mMax - mMin) * (1.f / 16777216.f)};
+				for(std::size_t i{0}; i < mCount; ++i) mOut[i] = mMin + (next() >> 8u) * scale;
+			}
+	};
+}
+
+#endif
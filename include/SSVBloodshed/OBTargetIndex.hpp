@@ -0,0 +1,119 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_TARGETINDEX
+#define SSVOB_TARGETINDEX
+
+#include <limits>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+	class OBCPhys;
+
+	struct OBTarget
+	{
+		OBCPhys* cPhys;
+		Vec2f pos; // Position at the time the group was indexed, in coords
+	};
+
+	class OBTargetIndex
+	{
+		// Spatial index of the targetable groups, shared by every component looking for a target
+		// Targets register their body under a group; the first query of a frame sorts that group by x, later queries binary search it
+		// Replaces targeters and vending machines scanning the manager's entities on their own every frame
+
+		private:
+			struct Group
+			{
+				std::vector<std::pair<OBCPhys*, const Body*>> registered;
+				std::vector<OBTarget> sorted;
+				bool dirty{true}; // Set on every change and on every new frame, as the bodies may have moved
+			};
+
+			std::unordered_map<unsigned int, Group> groups;
+
+			inline const std::vector<OBTarget>* getSorted(OBGroup mGroup)
+			{
+				auto itr(groups.find(mGroup));
+				if(itr == std::end(groups)) return nullptr;
+
+				auto& g(itr->second);
+				if(g.dirty)
+				{
+					g.dirty = false;
+					g.sorted.clear();
+					for(const auto& r : g.registered) g.sorted.push_back({r.first, Vec2f(r.second->getPosition())});
+					std::sort(std::begin(g.sorted), std::end(g.sorted), [](const OBTarget& mA, const OBTarget& mB){ return mA.pos.x < mB.pos.x; });
+				}
+				return g.sorted.empty() ? nullptr : &g.sorted;
+			}
+
+			inline static std::vector<OBTarget>::const_iterator getLowerBound(const std::vector<OBTarget>& mSorted, float mX)
+			{
+				return std::lower_bound(std::begin(mSorted), std::end(mSorted), mX, [](const OBTarget& mT, float mV){ return mT.pos.x < mV; });
+			}
+			inline static float getDistSquared(const Vec2f& mA, const Vec2f& mB) noexcept { Vec2f d{mA - mB}; return d.x * d.x + d.y * d.y; }
+
+		public:
+			inline void newFrame() noexcept { for(auto& p : groups) p.second.dirty = true; }
+			inline void clear() { groups.clear(); }
+
+			inline void add(OBGroup mGroup, OBCPhys& mCPhys, const Body& mBody)
+			{
+				auto& g(groups[mGroup]);
+				g.registered.emplace_back(&mCPhys, &mBody); g.dirty = true;
+			}
+			inline void del(OBGroup mGroup, OBCPhys& mCPhys)
+			{
+				auto itr(groups.find(mGroup));
+				if(itr == std::end(groups)) return;
+				ssvu::eraseRemoveIf(itr->second.registered, [&mCPhys](const std::pair<OBCPhys*, const Body*>& mR){ return mR.first == &mCPhys; });
+				itr->second.dirty = true;
+			}
+
+			// Calls `mFn` with the OBCPhys of every target registered under `mGroup`, in no particular order
+			template<typename TF> inline void forAll(OBGroup mGroup, const TF& mFn)
+			{
+				auto itr(groups.find(mGroup));
+				if(itr == std::end(groups)) return;
+				for(const auto& r : itr->second.registered) mFn(*r.first);
+			}
+
+			// Target of `mGroup` nearest to `mPos`, or nullptr if the group is empty
+			// Walks outwards from `mPos.x` in both directions, stopping as soon as the x distance alone exceeds the best match
+			inline const OBTarget* getNearest(OBGroup mGroup, const Vec2f& mPos)
+			{
+				const auto* sorted(getSorted(mGroup));
+				if(sorted == nullptr) return nullptr;
+
+				const OBTarget* result{nullptr};
+				float best{std::numeric_limits<float>::max()};
+				auto check = [&](const OBTarget& mT, float mDX) -> bool
+				{
+					if(mDX * mDX >= best) return false;
+					float dist{getDistSquared(mT.pos, mPos)};
+					if(dist < best) { best = dist; result = &mT; }
+					return true;
+				};
+
+				auto mid(getLowerBound(*sorted, mPos.x));
+				for(auto itr(mid); itr != std::end(*sorted); ++itr) if(!check(*itr, itr->pos.x - mPos.x)) break;
+				for(auto itr(mid); itr != std::begin(*sorted);) { --itr; if(!check(*itr, mPos.x - itr->pos.x)) break; }
+				return result;
+			}
+
+			// Calls `mFn` with every target of `mGroup` closer than `mRadius` to `mPos`
+			template<typename TF> inline void forWithin(OBGroup mGroup, const Vec2f& mPos, float mRadius, const TF& mFn)
+			{
+				const auto* sorted(getSorted(mGroup));
+				if(sorted == nullptr) return;
+
+				for(auto itr(getLowerBound(*sorted, mPos.x - mRadius)); itr != std::end(*sorted) && itr->pos.x < mPos.x + mRadius; ++itr)
+					if(getDistSquared(itr->pos, mPos) < mRadius * mRadius) mFn(*itr);
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,147 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_TILELAYER
+#define SSVOB_TILELAYER
+
+#include <bitset>
+#include <limits>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+	struct OBTileContact
+	{
+		Vec2i resolution;	// Offset applied to the body, zero if it was only detected
+		bool bound;			// True if the tile is outside of the level
+	};
+
+	class OBTileLayer : public sf::Drawable
+	{
+		// Static collision layer of the current level: plain walls are cells of a bitset instead of bodies in the world's HashGrid
+		// Everything outside of the level is solid too and replaces the old level bound bodies
+		// Dynamic bodies are resolved against the cells they overlap, all walls are drawn as a single vertex batch
+
+		private:
+			static constexpr int cellCoords{toCoords(tileSize)};
+			sf::Texture& texture;
+			std::bitset<levelCols * levelRows> walls;
+			std::vector<sf::Vertex> vertices;
+			std::size_t version{0}; // Incremented on every change, lets caches built on the layer know when to reset
+
+			// Smallest offset that pushes the box out of cell `mX, mY`, ignoring directions that lead into another solid cell
+			// This keeps bodies from snagging on the seams between adjacent walls
+			inline Vec2i getResolution(int mLeft, int mRight, int mTop, int mBottom, int mX, int mY) const noexcept
+			{
+				int l{mX * cellCoords}, t{mY * cellCoords};
+				std::array<std::pair<Vec2i, bool>, 4> candidates
+				{{
+					{{l - mRight, 0},				!isSolid(mX - 1, mY)},
+					{{l + cellCoords - mLeft, 0},	!isSolid(mX + 1, mY)},
+					{{0, t - mBottom},				!isSolid(mX, mY - 1)},
+					{{0, t + cellCoords - mTop},	!isSolid(mX, mY + 1)}
+				}};
+
+				bool anyFree{false};
+				for(const auto& c : candidates) anyFree |= c.second;
+
+				Vec2i result; int best{std::numeric_limits<int>::max()};
+				for(const auto& c : candidates)
+				{
+					if(anyFree && !c.second) continue;
+					int mag{std::abs(c.first.x) + std::abs(c.first.y)};
+					if(mag < best) { best = mag; result = c.first; }
+				}
+				return result;
+			}
+
+		public:
+			inline OBTileLayer(sf::Texture& mTexture) : texture(mTexture) { }
+
+			inline void clear() { walls.reset(); vertices.clear(); ++version; }
+
+			// `mPos` is any position inside the cell, in coords
+			inline void createWall(const Vec2i& mPos, const sf::IntRect& mRect)
+			{
+				int x{getCell(mPos.x)}, y{getCell(mPos.y)};
+				if(!isInside(x, y) || walls[y * levelCols + x]) return;
+				walls[y * levelCols + x] = true;
+				++version;
+
+				float l(x * tileSize), t(y * tileSize), r(l + tileSize), b(t + tileSize);
+				float tl(mRect.left), tt(mRect.top), tr(tl + mRect.width), tb(tt + mRect.height);
+				vertices.emplace_back(Vec2f{l, t}, Vec2f{tl, tt});
+				vertices.emplace_back(Vec2f{r, t}, Vec2f{tr, tt});
+				vertices.emplace_back(Vec2f{r, b}, Vec2f{tr, tb});
+				vertices.emplace_back(Vec2f{l, b}, Vec2f{tl, tb});
+			}
+
+			// Calls `mFn` with an OBTileContact for every solid cell overlapped by `mBody`, before the contact is resolved
+			// If `mResolve` is true the body is then pushed out of the cell, and its velocity towards it is reflected using the body's restitution
+			template<typename TF> inline void collide(Body& mBody, bool mResolve, const TF& mFn) const
+			{
+				const auto& start(mBody.getShape());
+				int x0{getCell(start.getLeft())}, x1{getCell(start.getRight() - 1)};
+				int y0{getCell(start.getTop())}, y1{getCell(start.getBottom() - 1)};
+
+				for(int y{y0}; y <= y1; ++y)
+					for(int x{x0}; x <= x1; ++x)
+					{
+						if(!isSolid(x, y)) continue;
+
+						// Previous resolutions may have already moved the body out of this cell
+						const auto& s(mBody.getShape());
+						int l(s.getLeft()), r(s.getRight()), t(s.getTop()), b(s.getBottom());
+						if(r <= x * cellCoords || l >= (x + 1) * cellCoords || b <= y * cellCoords || t >= (y + 1) * cellCoords) continue;
+
+						OBTileContact contact{mResolve ? getResolution(l, r, t, b, x, y) : ssvs::zeroVec2i, !isInside(x, y)};
+						mFn(contact);
+						if(!mResolve) continue;
+
+						mBody.resolvePosition(contact.resolution);
+
+						auto vel(mBody.getVelocity());
+						if(contact.resolution.x * vel.x < 0) vel.x *= -mBody.getRestitutionX();
+						if(contact.resolution.y * vel.y < 0) vel.y *= -mBody.getRestitutionY();
+						mBody.setVelocity(vel);
+					}
+			}
+
+			// Walks the cells crossed by the segment from `mA` to `mB` (in coords) and returns true if any of them is solid
+			inline bool isSegmentBlocked(const Vec2i& mA, const Vec2i& mB) const noexcept
+			{
+				constexpr float inf{std::numeric_limits<float>::infinity()};
+				Vec2f dir(mB - mA);
+				int x{getCell(mA.x)}, y{getCell(mA.y)}, stepX{dir.x > 0 ? 1 : -1}, stepY{dir.y > 0 ? 1 : -1};
+
+				// Segment parameter at which the next vertical/horizontal cell border is crossed, and the step between borders
+				float deltaX{dir.x != 0 ? cellCoords / std::abs(dir.x) : inf}, deltaY{dir.y != 0 ? cellCoords / std::abs(dir.y) : inf};
+				float nextX{dir.x != 0 ? ((stepX > 0 ? (x + 1) * cellCoords - mA.x : mA.x - x * cellCoords) / std::abs(dir.x)) : inf};
+				float nextY{dir.y != 0 ? ((stepY > 0 ? (y + 1) * cellCoords - mA.y : mA.y - y * cellCoords) / std::abs(dir.y)) : inf};
+
+				while(true)
+				{
+					if(isSolid(x, y)) return true;
+					if(nextX > 1.f && nextY > 1.f) return false;
+					if(nextX < nextY) { nextX += deltaX; x += stepX; } else { nextY += deltaY; y += stepY; }
+				}
+			}
+
+			inline void draw(sf::RenderTarget& mRenderTarget, sf::RenderStates mRenderStates) const override
+			{
+				if(vertices.empty()) return;
+				mRenderStates.texture = &texture;
+				mRenderTarget.draw(&vertices[0], vertices.size(), sf::PrimitiveType::Quads, mRenderStates);
+			}
+
+			inline static int getCell(float mCoord) noexcept { return std::floor(mCoord / cellCoords); }
+			inline static bool isInside(int mX, int mY) noexcept { return mX >= 0 && mY >= 0 && mX < levelCols && mY < levelRows; }
+			inline bool isSolid(int mX, int mY) const noexcept { return !isInside(mX, mY) || walls[mY * levelCols + mX]; }
+			inline bool isSolidPx(float mX, float mY) const noexcept { return isSolid(std::floor(mX / tileSize), std::floor(mY / tileSize)); }
+			inline std::size_t getWallCount() const noexcept { return vertices.size() / 4; }
+			inline std::size_t getVersion() const noexcept { return version; }
+	};
+}
+
+#endif
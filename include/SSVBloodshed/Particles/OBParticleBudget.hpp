@@ -0,0 +1,51 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_PARTICLES_PARTICLEBUDGET
+#define SSVOB_PARTICLES_PARTICLEBUDGET
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBConfig.hpp"
+
+namespace ob
+{
+	class OBParticleBudget
+	{
+		// Scales particle emission counts and caps to keep the measured update+draw time near OBConfig's target
+		// Cosmetic particles (psTemp, psTempAdd) are scaled down first, permanent ones only once cosmetic ones hit their minimum
+		// When there is room again, permanent particles are restored first
+
+		private:
+			const float smoothing{0.1f};					// Weight of the newest sample in the moving average
+			const float stepDown{0.95f}, stepUp{1.02f};		// Scale change per frame when over/under budget
+			const float minCosmetic{0.1f}, minPermanent{0.25f};
+
+			float avgMs{0.f}, scaleCosmetic{1.f}, scalePermanent{1.f};
+
+		public:
+			inline void addFrameTime(float mMs) noexcept
+			{
+				avgMs = avgMs == 0.f ? mMs : avgMs + (mMs - avgMs) * smoothing;
+				if(!OBConfig::isParticleBudgetEnabled()) { scaleCosmetic = scalePermanent = 1.f; return; }
+
+				auto target(OBConfig::getParticleBudgetMs());
+
+				if(avgMs > target * 1.05f)
+				{
+					if(scaleCosmetic > minCosmetic) scaleCosmetic = std::max(minCosmetic, scaleCosmetic * stepDown);
+					else scalePermanent = std::max(minPermanent, scalePermanent * stepDown);
+				}
+				else if(avgMs < target * 0.85f)
+				{
+					if(scalePermanent < 1.f) scalePermanent = std::min(1.f, scalePermanent * stepUp);
+					else scaleCosmetic = std::min(1.f, scaleCosmetic * stepUp);
+				}
+			}
+
+			inline float getScale(bool mPermanent) const noexcept { return mPermanent ? scalePermanent : scaleCosmetic; }
+			inline float getAvgMs() const noexcept { return avgMs; }
+	};
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_PARTICLES_PARTICLEBUFFER
+#define SSVOB_PARTICLES_PARTICLEBUFFER
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+	class OBParticleBuffer
+	{
+		// Structure-of-arrays particle storage: every attribute lives in its own contiguous float array
+		// The update kernels are short branchless loops over those arrays, which the compiler vectorizes (SSE/AVX) at -O3
+		// Loops are kept small on purpose: each one has few enough arrays for the compiler's runtime aliasing checks
+
+		public:
+			enum Attr : std::size_t { AX, AY, AVelX, AVelY, ACurveCos, ACurveSin, AAccel, ASize, ALife, AAlphaScale, AFuzziness, AAlpha, AAge, ACount };
+
+		private:
+			std::array<std::vector<float>, Attr::ACount> attrs;
+			std::vector<sf::Color> colors;
+			std::size_t count{0};
+
+		public:
+			inline void reserve(std::size_t mCapacity) { for(auto& a : attrs) a.reserve(mCapacity); colors.reserve(mCapacity); }
+
+			inline void emplace(const Vec2f& mPos, const Vec2f& mVel, float mSize, float mLife, float mCurveSpd, float mFuzziness, float mAccel, float mAlphaMult, const sf::Color& mColor)
+			{
+				// The curve is applied as a fixed rotation every update, so its sine and cosine are computed only once
+				float curveRad{ssvu::toRad(mCurveSpd)};
+
+				attrs[AX].push_back(mPos.x);					attrs[AY].push_back(mPos.y);
+				attrs[AVelX].push_back(mVel.x);					attrs[AVelY].push_back(mVel.y);
+				attrs[ACurveCos].push_back(std::cos(curveRad));	attrs[ACurveSin].push_back(std::sin(curveRad));
+				attrs[AAccel].push_back(mAccel);				attrs[ASize].push_back(mSize);
+				attrs[ALife].push_back(mLife);					attrs[AAlphaScale].push_back(255.f / mLife * mAlphaMult);
+				attrs[AFuzziness].push_back(mFuzziness);		attrs[AAlpha].push_back(0.f);
+				attrs[AAge].push_back(0.f);
+				colors.push_back(mColor);
+				++count;
+			}
+
+			// Appends `mCount` uninitialized particles and returns the index of the first one, to be filled in place
+			inline std::size_t grow(std::size_t mCount)
+			{
+				auto first(count);
+				count += mCount;
+				for(auto& a : attrs) a.resize(count);
+				colors.resize(count);
+				return first;
+			}
+
+			inline void update(FT mFT) noexcept
+			{
+				float* x(get(AX)); float* y(get(AY)); float* velX(get(AVelX)); float* velY(get(AVelY));
+				const float* curveCos(get(ACurveCos)); const float* curveSin(get(ACurveSin)); const float* accel(get(AAccel));
+				float* life(get(ALife)); const float* alphaScale(get(AAlphaScale)); float* alpha(get(AAlpha)); float* age(get(AAge));
+				const std::size_t n{count};
+
+				for(std::size_t i{0}; i < n; ++i)
+				{
+					life[i] -= mFT;
+					alpha[i] = ssvu::getClamped(life[i] * alphaScale[i], 0.f, 255.f);
+				}
+
+				for(std::size_t i{0}; i < n; ++i) age[i] += mFT;
+
+				for(std::size_t i{0}; i < n; ++i)
+				{
+					float vx{velX[i]}, vy{velY[i]};
+					velX[i] = (vx * curveCos[i] - vy * curveSin[i]) * accel[i];
+					velY[i] = (vx * curveSin[i] + vy * curveCos[i]) * accel[i];
+				}
+
+				for(std::size_t i{0}; i < n; ++i) x[i] += velX[i] * mFT;
+				for(std::size_t i{0}; i < n; ++i) y[i] += velY[i] * mFT;
+			}
+
+			// Keeps only the first `mCount` particles
+			inline void truncate(std::size_t mCount)
+			{
+				if(mCount >= count) return;
+				for(auto& a : attrs) a.resize(mCount);
+				colors.resize(mCount); count = mCount;
+			}
+
+			// Removes the particle at `mIdx` in O(1) by moving the last particle in its place
+			inline void swapRemove(std::size_t mIdx) noexcept
+			{
+				assert(mIdx < count);
+				for(auto& a : attrs) { a[mIdx] = a.back(); a.pop_back(); }
+				colors[mIdx] = colors.back(); colors.pop_back();
+				--count;
+			}
+
+			// Removes the particles whose life has run out, without preserving order
+			inline void removeDead() noexcept
+			{
+				const float* life(get(ALife));
+				for(std::size_t i{0}; i < count;)
+				{
+					if(life[i] > 0) ++i;
+					else swapRemove(i);
+				}
+			}
+
+			inline void clear() { for(auto& a : attrs) a.clear(); colors.clear(); count = 0; }
+
+			inline float* get(Attr mAttr) noexcept							{ return attrs[mAttr].data(); }
+			inline const float* get(Attr mAttr) const noexcept				{ return attrs[mAttr].data(); }
+			inline sf::Color& getColor(std::size_t mIdx) noexcept				{ return colors[mIdx]; }
+			inline const sf::Color& getColor(std::size_t mIdx) const noexcept	{ return colors[mIdx]; }
+			inline std::size_t getCount() const noexcept						{ return count; }
+	};
+}
+
+#endif
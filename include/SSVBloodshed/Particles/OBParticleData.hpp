@@ -20,12 +20,6 @@ namespace ob
 		std::vector<ColorRng> colorRngs;
 	};
 
-	inline int getRndRngI(const OBParticleData::RngI& mRng) noexcept	{ return ssvu::getRnd(std::get<0>(mRng), std::get<1>(mRng)); }
-	inline float getRndRngF(const OBParticleData::RngF& mRng) noexcept	{ return ssvu::getRndR(std::get<0>(mRng), std::get<1>(mRng)); }
-	inline sf::Color getColorFromRng(const OBParticleData::ColorRng& mRng) noexcept
-	{
-		return sf::Color(getRndRngI(std::get<0>(mRng)), getRndRngI(std::get<1>(mRng)), getRndRngI(std::get<2>(mRng)), getRndRngI(std::get<3>(mRng)));
-	}
 }
 
 namespace ssvuj
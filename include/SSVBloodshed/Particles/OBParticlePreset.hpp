@@ -0,0 +1,89 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_PARTICLES_PARTICLEPRESET
+#define SSVOB_PARTICLES_PARTICLEPRESET
+
+#include <stdexcept>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/Particles/OBParticleData.hpp"
+
+namespace ob
+{
+	enum class OBParticleTarget : int { Perm, Temp, TempAdd };
+
+	struct OBParticlePreset
+	{
+		// Emission-ready form of an OBParticleData, compiled and validated once when assets are loaded
+		// Curve speeds are stored in radians and the alpha multiplier is premultiplied by 255
+
+		using RngF = OBParticleData::RngF;
+		using ColorRng = std::array<OBParticleData::RngI, 4>;
+
+		std::string name;
+		OBParticleTarget target;
+		sf::BlendMode blendMode;
+		RngF angleRng, velRng, sizeRng, lifeRng, curveRadRng, fuzzinessRng, accelRng, distRng;
+		float alphaNumerator; // Alpha scale of a particle is `alphaNumerator / life`
+		std::vector<ColorRng> colorRngs;
+	};
+
+	namespace Internal
+	{
+		inline void validatePreset(bool mCondition, const std::string& mName, const std::string& mError)
+		{
+			if(mCondition) return;
+
+			ssvu::lo("OBParticlePreset") << "Invalid particle data `" << mName << "`: " << mError << std::endl;
+			throw std::runtime_error{"Invalid particle data `" + mName + "`: " + mError};
+		}
+		inline void validateRng(const OBParticleData::RngF& mRng, const std::string& mName, const std::string& mRngName)
+		{
+			validatePreset(std::isfinite(mRng.first) && std::isfinite(mRng.second), mName, mRngName + " is not finite");
+			validatePreset(mRng.first <= mRng.second, mName, mRngName + " has min greater than max");
+		}
+	}
+
+	// Validates `mData` and compiles it, throws if the data would produce invalid particles
+	inline OBParticlePreset compileParticlePreset(const std::string& mName, const OBParticleData& mData, OBParticleTarget mTarget)
+	{
+		using namespace Internal;
+
+		validateRng(mData.angleRng, mName, "angle range");
+		validateRng(mData.velRng, mName, "velocity range");
+		validateRng(mData.sizeRng, mName, "size range");
+		validateRng(mData.lifeRng, mName, "life range");
+		validateRng(mData.curveSpdRng, mName, "curve speed range");
+		validateRng(mData.fuzzinessRng, mName, "fuzziness range");
+		validateRng(mData.accelRng, mName, "acceleration range");
+		validateRng(mData.distRng, mName, "distance range");
+		validatePreset(mData.sizeRng.first >= 0.f, mName, "size range must not be negative");
+		validatePreset(mData.lifeRng.first > 0.f, mName, "life range must be positive");
+		validatePreset(mData.fuzzinessRng.first >= 0.f, mName, "fuzziness range must not be negative");
+		validatePreset(std::isfinite(mData.alphaMult) && mData.alphaMult >= 0.f, mName, "alpha multiplier must be finite and non-negative");
+		validatePreset(!mData.colorRngs.empty(), mName, "no color ranges");
+
+		OBParticlePreset result;
+		result.name = mName;
+		result.target = mTarget;
+		result.blendMode = mTarget == OBParticleTarget::TempAdd ? sf::BlendMode::BlendAdd : sf::BlendMode::BlendAlpha;
+		result.angleRng = mData.angleRng; result.velRng = mData.velRng; result.sizeRng = mData.sizeRng; result.lifeRng = mData.lifeRng;
+		result.curveRadRng = {ssvu::toRad(mData.curveSpdRng.first), ssvu::toRad(mData.curveSpdRng.second)};
+		result.fuzzinessRng = mData.fuzzinessRng; result.accelRng = mData.accelRng; result.distRng = mData.distRng;
+		result.alphaNumerator = 255.f * mData.alphaMult;
+
+		for(const auto& c : mData.colorRngs)
+		{
+			OBParticlePreset::ColorRng channels{{std::get<0>(c), std::get<1>(c), std::get<2>(c), std::get<3>(c)}};
+			for(const auto& ch : channels)
+				validatePreset(ch.first >= 0 && ch.first < ch.second && ch.second <= 256, mName, "color channel ranges must be [min, max) within [0, 256)");
+
+			result.colorRngs.emplace_back(channels);
+		}
+
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_PARTICLES_PARTICLERATE
+#define SSVOB_PARTICLES_PARTICLERATE
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+	class OBParticleRate
+	{
+		// Turns a rate in particles per second into a whole particle count for every update, whatever the frame time
+		// The fractional remainder is carried over to the next update, an optional burst adds particles at a fixed interval
+		// Frame time is ssvs' FT, where 1 is a 60th of a second
+
+		private:
+			float perSecond, accumulator{0.f};
+			float burstInterval{0.f}, burstTimer{0.f};
+			std::size_t burstCount{0};
+
+		public:
+			inline OBParticleRate(float mPerSecond = 0.f) noexcept : perSecond{mPerSecond} { }
+
+			inline std::size_t advance(FT mFT) noexcept
+			{
+				float seconds{mFT / 60.f};
+
+				accumulator += perSecond * seconds;
+				auto result(static_cast<std::size_t>(accumulator));
+				accumulator -= result;
+
+				if(burstInterval > 0.f)
+					for(burstTimer += seconds; burstTimer >= burstInterval; burstTimer -= burstInterval) result += burstCount;
+
+				return result;
+			}
+
+			inline void reset() noexcept { accumulator = burstTimer = 0.f; }
+
+			inline void setPerSecond(float mValue) noexcept { perSecond = mValue; }
+			inline void setBurst(std::size_t mCount, float mIntervalSeconds) noexcept { burstCount = mCount; burstInterval = mIntervalSeconds; }
+
+			inline float getPerSecond() const noexcept { return perSecond; }
+	};
+}
+
+#endif
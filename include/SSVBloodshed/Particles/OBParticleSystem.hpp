@@ -5,9 +5,12 @@
 #ifndef SSVOB_PARTICLES_PARTICLESYSTEM
 #define SSVOB_PARTICLES_PARTICLESYSTEM
 
-#include "SSVBloodshed/Particles/OBParticle.hpp"
+#include "SSVBloodshed/Particles/OBParticleBuffer.hpp"
+#include "SSVBloodshed/Particles/OBParticlePreset.hpp"
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
+#include "SSVBloodshed/OBRng.hpp"
+#include "SSVBloodshed/OBTileLayer.hpp"
 
 namespace ob
 {
@@ -15,40 +18,241 @@ namespace ob
 	{
 		private:
 			ssvs::VertexVector<sf::PrimitiveType::Quads> vertices;
-			std::vector<OBParticle> particles;
+			OBParticleBuffer particles;
+			OBRng rng;
+			std::vector<float> fuzz; // Three random numbers in [-1, 1) per particle, generated in bulk every update
 			std::size_t currentCount{0};
+			float budgetScale{1.f}; // Fraction of OBConfig's particle maximum this system may use, set by OBParticleBudget
+			float budgetRemainder{0.f}; // Fractional particles left over by getBudgeted(), carried to the next emission
+
+			// Decal baking: particles drawn on a never-cleared target are stamped once when they come to rest, then dropped
+			// Stamped quads are queued in `decals` until the next draw, or blended straight into `decalImage` when one is set
+			// A particle must also be at least `decalMinAge` old, so that the ones spawned almost still get to spread first
+			bool bakeDecals{false};
+			float decalRestSpeed{0.05f}, decalMinAge{8.f};
+			std::vector<sf::Vertex> decals;
+			sf::Image* decalImage{nullptr};
+
+			// Optional collision against the level's static tile layer: particles entering a wall tile bounce back on the blocked axis
+			const OBTileLayer* tileLayer{nullptr};
+			float restitution{0.f};
+
+			inline void setQuad(sf::Vertex* mQuad, std::size_t mIdx, float mFz0, float mFz1, float mFz2) const noexcept
+			{
+				float x{particles.get(OBParticleBuffer::AX)[mIdx]}, y{particles.get(OBParticleBuffer::AY)[mIdx]};
+				float size{particles.get(OBParticleBuffer::ASize)[mIdx]};
+
+				mQuad[0].position = {x - size + mFz0, y - size + mFz1};
+				mQuad[1].position = {x + size + mFz2, y - size + mFz0};
+				mQuad[2].position = {x + size + mFz0, y + size + mFz1};
+				mQuad[3].position = {x - size + mFz1, y + size + mFz2};
+
+				sf::Color color{particles.getColor(mIdx)}; color.a = particles.get(OBParticleBuffer::AAlpha)[mIdx];
+				mQuad[0].color = mQuad[1].color = mQuad[2].color = mQuad[3].color = color;
+			}
+
+			inline void updateVertices()
+			{
+				const float* fuzziness(particles.get(OBParticleBuffer::AFuzziness));
+
+				fuzz.resize(currentCount * 3);
+				rng.fill(fuzz.data(), fuzz.size(), -1.f, 1.f);
+
+				for(auto i(0u); i < currentCount; ++i)
+					setQuad(&vertices[i * 4], i, fuzz[i * 3 + 0] * fuzziness[i], fuzz[i * 3 + 1] * fuzziness[i], fuzz[i * 3 + 2] * fuzziness[i]);
+			}
+
+			// CPU equivalent of drawing a quad with sf::BlendAlpha, using the quad's bounding box
+			inline static void stampQuad(sf::Image& mImage, const sf::Vertex* mQuad)
+			{
+				float minX{mQuad[0].position.x}, maxX{minX}, minY{mQuad[0].position.y}, maxY{minY};
+				for(auto i(1u); i < 4; ++i)
+				{
+					minX = std::min(minX, mQuad[i].position.x); maxX = std::max(maxX, mQuad[i].position.x);
+					minY = std::min(minY, mQuad[i].position.y); maxY = std::max(maxY, mQuad[i].position.y);
+				}
+
+				auto imgSize(mImage.getSize());
+				int x0(std::max(0, int(std::ceil(minX - 0.5f)))), x1(std::min(int(imgSize.x), int(std::ceil(maxX - 0.5f))));
+				int y0(std::max(0, int(std::ceil(minY - 0.5f)))), y1(std::min(int(imgSize.y), int(std::ceil(maxY - 0.5f))));
+
+				const auto& src(mQuad[0].color);
+				const float a{src.a / 255.f};
+
+				for(int iY{y0}; iY < y1; ++iY)
+					for(int iX{x0}; iX < x1; ++iX)
+					{
+						auto dst(mImage.getPixel(iX, iY));
+						dst.r = sf::Uint8(src.r * a + dst.r * (1.f - a));
+						dst.g = sf::Uint8(src.g * a + dst.g * (1.f - a));
+						dst.b = sf::Uint8(src.b * a + dst.b * (1.f - a));
+						dst.a = sf::Uint8(src.a + dst.a * (1.f - a));
+						mImage.setPixel(iX, iY, dst);
+					}
+			}
+
+			inline void collide(FT mFT) noexcept
+			{
+				float* x(particles.get(OBParticleBuffer::AX)); float* y(particles.get(OBParticleBuffer::AY));
+				float* velX(particles.get(OBParticleBuffer::AVelX)); float* velY(particles.get(OBParticleBuffer::AVelY));
+
+				for(std::size_t i{0}; i < particles.getCount(); ++i)
+				{
+					if(!tileLayer->isSolidPx(x[i], y[i])) continue;
+
+					// Step back to the previous position and find which axis moved the particle into the wall
+					float prevX{x[i] - velX[i] * mFT}, prevY{y[i] - velY[i] * mFT};
+					bool hitX{tileLayer->isSolidPx(x[i], prevY)}, hitY{tileLayer->isSolidPx(prevX, y[i])};
+					if(!hitX && !hitY) hitX = hitY = true; // Corner
+
+					if(hitX) { x[i] = prevX; velX[i] *= -restitution; }
+					if(hitY) { y[i] = prevY; velY[i] *= -restitution; }
+				}
+			}
+
+			inline void bakeRestingParticles()
+			{
+				const float* velX(particles.get(OBParticleBuffer::AVelX));
+				const float* velY(particles.get(OBParticleBuffer::AVelY));
+				const float* fuzziness(particles.get(OBParticleBuffer::AFuzziness));
+				const float* age(particles.get(OBParticleBuffer::AAge));
+				const float restSpeedSq{decalRestSpeed * decalRestSpeed};
+
+				for(std::size_t i{0}; i < particles.getCount();)
+				{
+					if(age[i] < decalMinAge || velX[i] * velX[i] + velY[i] * velY[i] >= restSpeedSq) { ++i; continue; }
+
+					float fz[3]; rng.fill(fz, 3, -fuzziness[i], fuzziness[i]);
+					sf::Vertex quad[4]; setQuad(quad, i, fz[0], fz[1], fz[2]);
+
+					// The particle would have kept being drawn over itself on the never-cleared target until nearly opaque,
+					// so the decal uses the color's own alpha instead of the current, fading one
+					for(auto& v : quad) v.color.a = particles.getColor(i).a;
+
+					if(decalImage != nullptr) stampQuad(*decalImage, quad);
+					else decals.insert(std::end(decals), std::begin(quad), std::end(quad));
+
+					particles.swapRemove(i);
+				}
+			}
+
+			inline std::size_t getMax() const noexcept { return OBConfig::getParticleMax() * budgetScale; }
 
 		public:
 			inline OBParticleSystem() { vertices.resize(OBConfig::getParticleMax() * 4); particles.reserve(OBConfig::getParticleMax()); }
-			template<typename... TArgs> inline void emplace(TArgs&&... mArgs) { particles.emplace_back(std::forward<TArgs>(mArgs)...); }
-			inline void update(FT mFT)
+
+			// Particles emplaced while the system is full are dropped
+			template<typename... TArgs> inline void emplace(TArgs&&... mArgs)
+			{
+				if(particles.getCount() < getMax()) particles.emplace(std::forward<TArgs>(mArgs)...);
+			}
+
+			// Emits `mCount` particles described by `mPreset`, spread around the `mPosCount` positions
+			// Space is reserved once and every attribute is filled as a contiguous block, mostly with bulk random generation
+			// Particles are dealt to the positions in turn, so that a batch clamped by the cap still reaches every position
+			inline void emit(const OBParticlePreset& mPreset, const Vec2f* mPositions, std::size_t mPosCount, std::size_t mCount, float mRad = 0.f, float mMult = 1.f, float mDistMult = 1.f)
 			{
-				// Remove excess particles
-				if(particles.size() > OBConfig::getParticleMax()) particles.erase(std::begin(particles) + OBConfig::getParticleMax(), std::end(particles));
+				auto total(std::min(mCount, getAvailable()));
+				if(total == 0) return;
 
-				ssvu::eraseRemoveIf(particles, [](const OBParticle& mParticle){ return mParticle.life <= 0; });
-				currentCount = particles.size();
+				auto first(particles.grow(total));
+				auto fill([this, first, total](OBParticleBuffer::Attr mAttr, const OBParticlePreset::RngF& mR)
+				{
+					rng.fill(particles.get(mAttr) + first, total, mR.first, mR.second);
+				});
 
-				for(auto i(0u); i < currentCount; ++i)
+				// Angle, distance and speed are rolled into the position and velocity arrays, then combined below
+				fill(OBParticleBuffer::AX, mPreset.angleRng);		fill(OBParticleBuffer::AY, mPreset.distRng);
+				fill(OBParticleBuffer::AVelY, mPreset.velRng);		fill(OBParticleBuffer::ASize, mPreset.sizeRng);
+				fill(OBParticleBuffer::ALife, mPreset.lifeRng);		fill(OBParticleBuffer::ACurveCos, mPreset.curveRadRng);
+				fill(OBParticleBuffer::AFuzziness, mPreset.fuzzinessRng);	fill(OBParticleBuffer::AAccel, mPreset.accelRng);
+
+				float* x(particles.get(OBParticleBuffer::AX) + first); float* y(particles.get(OBParticleBuffer::AY) + first);
+				float* velX(particles.get(OBParticleBuffer::AVelX) + first); float* velY(particles.get(OBParticleBuffer::AVelY) + first);
+				float* curveCos(particles.get(OBParticleBuffer::ACurveCos) + first); float* curveSin(particles.get(OBParticleBuffer::ACurveSin) + first);
+				const float* life(particles.get(OBParticleBuffer::ALife) + first);
+				float* alphaScale(particles.get(OBParticleBuffer::AAlphaScale) + first); float* alpha(particles.get(OBParticleBuffer::AAlpha) + first);
+				float* age(particles.get(OBParticleBuffer::AAge) + first);
+
+				for(std::size_t i{0}; i < total; ++i)
 				{
-					auto& p(particles[i]); p.update(mFT);
-					const auto& vIdx(i * 4);
+					const auto& pos(mPositions[i % mPosCount]);
+					float rad{mRad + x[i]}, dirX{std::cos(rad)}, dirY{std::sin(rad)}, dist{y[i] * mDistMult}, speed{velY[i] * mMult};
 
-					auto& vNW(vertices[vIdx + 0]);
-					auto& vNE(vertices[vIdx + 1]);
-					auto& vSE(vertices[vIdx + 2]);
-					auto& vSW(vertices[vIdx + 3]);
+					x[i] = pos.x + dirX * dist;		y[i] = pos.y + dirY * dist;
+					velX[i] = dirX * speed;			velY[i] = dirY * speed;
 
-					vNW.position = p.nw;
-					vNE.position = p.ne;
-					vSE.position = p.se;
-					vSW.position = p.sw;
+					float curveRad{curveCos[i]};
+					curveCos[i] = std::cos(curveRad); curveSin[i] = std::sin(curveRad);
 
-					vNW.color = vNE.color = vSE.color = vSW.color = p.color;
+					alphaScale[i] = mPreset.alphaNumerator / life[i];
+					alpha[i] = 0.f; age[i] = 0.f;
+
+					const auto& c(mPreset.colorRngs[rng.getRnd(std::size_t{0}, mPreset.colorRngs.size())]);
+					particles.getColor(first + i) = sf::Color(rng.getRnd(c[0].first, c[0].second), rng.getRnd(c[1].first, c[1].second),
+						rng.getRnd(c[2].first, c[2].second), rng.getRnd(c[3].first, c[3].second));
 				}
 			}
-			inline void draw(sf::RenderTarget& mRenderTarget, sf::RenderStates mRenderStates) const override { mRenderTarget.draw(&vertices[0], currentCount * 4, sf::PrimitiveType::Quads, mRenderStates); }
-			inline void clear() { particles.clear(); currentCount = 0; }
+
+			inline void update(FT mFT)
+			{
+				// Remove excess particles, only needed if the maximum or the budget was lowered at runtime
+				particles.truncate(getMax());
+
+				particles.removeDead();
+				particles.update(mFT);
+				if(tileLayer != nullptr) collide(mFT);
+				if(bakeDecals) bakeRestingParticles();
+				currentCount = particles.getCount();
+
+				// Live particles map to the first `currentCount` quads, which are overwritten in place
+				if(vertices.size() < currentCount * 4) vertices.resize(currentCount * 4);
+				updateVertices();
+			}
+			inline void draw(sf::RenderTarget& mRenderTarget, sf::RenderStates mRenderStates) const override
+			{
+				if(!decals.empty()) mRenderTarget.draw(&decals[0], decals.size(), sf::PrimitiveType::Quads, mRenderStates);
+				mRenderTarget.draw(&vertices[0], currentCount * 4, sf::PrimitiveType::Quads, mRenderStates);
+			}
+			inline void clear() { particles.clear(); decals.clear(); currentCount = 0; budgetRemainder = 0.f; }
+
+			// Must be called after every draw when baking decals, as queued decals have to be drawn exactly once
+			inline void clearDecals() noexcept { decals.clear(); }
+
+			// Only enable baking when the target this system is drawn on is never cleared
+			inline void setBakeDecals(bool mValue) noexcept				{ bakeDecals = mValue; }
+			inline void setDecalRestSpeed(float mValue) noexcept		{ decalRestSpeed = mValue; }
+			inline void setDecalMinAge(float mValue) noexcept			{ decalMinAge = mValue; }
+
+			// Headless mode: decals are blended into `mImage` on the CPU instead of being queued for drawing
+			inline void setDecalImage(sf::Image* mImage) noexcept		{ decalImage = mImage; }
+
+			inline void setBudgetScale(float mValue) noexcept	{ budgetScale = mValue; }
+
+			// Scales `mCount` by the budget, carrying the fractional remainder over to the next call like OBParticleRate does
+			// Small emissions are then thinned out on average instead of always rounding back up
+			inline std::size_t getBudgeted(std::size_t mCount) noexcept
+			{
+				float scaled{mCount * budgetScale + budgetRemainder};
+				auto result(static_cast<std::size_t>(scaled));
+				budgetRemainder = scaled - result;
+				return result;
+			}
+
+			// `mRestitution` is the fraction of speed kept when bouncing, 0 makes particles stop at walls
+			inline void setCollisionLayer(const OBTileLayer* mTileLayer, float mRestitution = 0.f) noexcept { tileLayer = mTileLayer; restitution = mRestitution; }
+
+			inline void seed(std::uint64_t mSeed) noexcept	{ rng.seed(mSeed); }
+			inline OBRng& getRng() noexcept					{ return rng; }
+
+			inline std::size_t getAvailable() const noexcept
+			{
+				auto max(getMax());
+				return particles.getCount() < max ? max - particles.getCount() : 0;
+			}
+			inline const OBParticleBuffer& getBuffer() const noexcept	{ return particles; }
+			inline std::size_t getCount() const noexcept				{ return particles.getCount(); }
+			inline std::size_t getDecalCount() const noexcept			{ return decals.size() / 4; }
 	};
 }
 
@@ -20,10 +20,10 @@
 #include "SSVBloodshed/Components/OBCDoor.hpp"
 #include "SSVBloodshed/Components/OBCPPlate.hpp"
 #include "SSVBloodshed/Components/OBCTrapdoor.hpp"
-#include "SSVBloodshed/Components/OBCShard.hpp"
 #include "SSVBloodshed/Components/OBCSpawner.hpp"
 #include "SSVBloodshed/Components/OBCDamageOnTouch.hpp"
 #include "SSVBloodshed/Components/OBCVMachine.hpp"
+#include "SSVBloodshed/Components/OBCDrawable.hpp"
 
 using namespace std;
 using namespace sf;
@@ -88,10 +88,16 @@ namespace ob
 		result.createComponent<OBCParticleSystem>(mRenderTexture, game.getGameWindow(), mClearOnDraw, mOpacity, mBlendMode);
 		return result;
 	}
-	Entity& OBFactory::createTrail(const Vec2i& mA, const Vec2i& mB, const Color& mColor)
+	Entity& OBFactory::createTrail(const Vec2i& mA, const std::vector<Vec2i>& mBs, const Color& mColor)
 	{
 		auto& result(manager.createEntity());
-		result.createComponent<OBCTrail>(game, mA, mB, mColor);
+		result.createComponent<OBCTrail>(game, mA, mBs, mColor);
+		return result;
+	}
+	Entity& OBFactory::createDrawable(const sf::Drawable& mDrawable, int mDrawPriority, sf::BlendMode mBlendMode)
+	{
+		auto& result(createEntity(mDrawPriority));
+		result.createComponent<OBCDrawable>(game, mDrawable, mBlendMode);
 		return result;
 	}
 
@@ -116,13 +122,7 @@ namespace ob
 		gt<Entity>(tpl).createComponent<OBCTrapdoor>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), mPlayerOnly);
 		return gt<Entity>(tpl);
 	}
-	Entity& OBFactory::createWall(const Vec2i& mPos, const sf::IntRect& mIntRect)
-	{
-		auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, true));
-		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, mIntRect);
-		gt<OBCPhys>(tpl).getBody().addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir);
-		return gt<Entity>(tpl);
-	}
+	void OBFactory::createWall(const Vec2i& mPos, const sf::IntRect& mIntRect) { game.getTileLayer().createWall(mPos, mIntRect); }
 	Entity& OBFactory::createWallDestructible(const Vec2i& mPos, const sf::IntRect& mIntRect)
 	{
 		auto tpl(createKillableBase(mPos, {1000, 1000}, OBLayer::LWall, 20));
@@ -136,7 +136,7 @@ namespace ob
 	{
 		auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, true));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, mIntRect);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		gt<Entity>(tpl).createComponent<OBCDoor>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mOpen);
 		return gt<Entity>(tpl);
 	}
@@ -177,7 +177,7 @@ namespace ob
 	{
 		auto tpl(createKillableBase(mPos, {1000, 1000}, OBLayer::LWall, 10));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.explosiveCrate);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		gt<OBCPhys>(tpl).getBody().addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir, OBGroup::GKillable, OBGroup::GFriendlyKillable, OBGroup::GEnemyKillable, OBGroup::GEnvDestructible);
 		gt<OBCPhys>(tpl).getBody().setStatic(true);
 		gt<OBCKillable>(tpl).setType(OBCKillable::Type::ExplosiveCrate);
@@ -190,18 +190,11 @@ namespace ob
 
 		return gt<Entity>(tpl);
 	}
-	Entity& OBFactory::createShard(const Vec2i& mPos)
-	{
-		auto tpl(createActorBase(mPos, {400, 400}, OBLayer::LShard));
-		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.shard);
-		gt<Entity>(tpl).createComponent<OBCShard>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl));
-		return gt<Entity>(tpl);
-	}
 	Entity& OBFactory::createSpawner(const Vec2i& mPos, SpawnerItem mType, int mId, float mDelayStart, float mDelaySpawn, int mSpawnCount)
 	{
 		auto tpl(createActorBase(mPos, {400, 400}, OBLayer::LShard));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.spawner);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		auto& cSpawner(gt<Entity>(tpl).createComponent<OBCSpawner>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mType, mDelayStart, mDelaySpawn, mSpawnCount));
 
 		if(mId != -1) cSpawner.setActive(false);
@@ -211,7 +204,7 @@ namespace ob
 	{
 		auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.ff0);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		gt<Entity>(tpl).createComponent<OBCForceField>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir, mBlockFriendly, mBlockEnemy, mForceMult);
 		gt<OBCDraw>(tpl).setBlendMode(sf::BlendMode::BlendAdd);
 		sf::Color color{225, 0, 0, 255};
@@ -232,7 +225,7 @@ namespace ob
 	{
 		auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.forceArrowMark);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		gt<Entity>(tpl).createComponent<OBCBulletForceField>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir, mBlockFriendly, mBlockEnemy);
 		gt<OBCDraw>(tpl).setBlendMode(sf::BlendMode::BlendAdd);
 
@@ -248,7 +241,7 @@ namespace ob
 	{
 		auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
 		emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.ff0);
-		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+		auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(gt<OBCPhys>(tpl), mId));
 		gt<Entity>(tpl).createComponent<OBCBooster>(gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir, mForceMult);
 		gt<OBCDraw>(tpl).setBlendMode(sf::BlendMode::BlendAdd);
 
@@ -442,8 +435,8 @@ namespace ob
 	}
 	Entity& OBFactory::createPJTestShell(const Vec2i& mPos, float mDeg)
 	{
-		auto tpl(createProjectileBase(mPos, {150, 150}, 320.f + getRnd(-5, 25), mDeg, assets.pjBullet));
-		gt<OBCProjectile>(tpl).setLife(10.f + getRnd(-5, 15));
+		auto tpl(createProjectileBase(mPos, {150, 150}, 320.f + rng.getRnd(-5, 25), mDeg, assets.pjBullet));
+		gt<OBCProjectile>(tpl).setLife(10.f + rng.getRnd(-5, 15));
 		gt<OBCProjectile>(tpl).setPierceOrganic(3);
 		return gt<Entity>(tpl);
 	}
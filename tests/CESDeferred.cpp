@@ -0,0 +1,48 @@
+// Copyright (c) 2013 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include <iostream>
+#include <memory>
+#include "SSVBloodshed/CESystem/CES.hpp"
+
+// Components created while a system is processing are deferred to the next refresh
+// Checks that their arguments survive the deferral: references still point at the originals, move-only values are moved in
+
+using namespace ssvces;
+
+struct CPosition : Component	{ float x, y; CPosition(float mX, float mY) : x{mX}, y{mY} { } };
+struct CFollower : Component	{ CPosition& target; CFollower(CPosition& mTarget) : target(mTarget) { } };
+struct COwned : Component		{ std::unique_ptr<int> value; COwned(std::unique_ptr<int> mValue) : value{std::move(mValue)} { } };
+
+struct SSpawnFollower : System<SSpawnFollower, Req<CPosition>, Not<CFollower>>
+{
+	inline void update() { processAll(); }
+	inline void process(Entity& entity, CPosition& cPosition)
+	{
+		entity.createComponent<CFollower>(std::ref(cPosition));
+		entity.createComponent<COwned>(std::unique_ptr<int>{new int{42}});
+	}
+};
+
+int main()
+{
+	Manager manager;
+	SSpawnFollower sSpawnFollower;
+	manager.registerSystem(sSpawnFollower);
+
+	auto e(manager.createEntity());
+	e.createComponent<CPosition>(1.f, 2.f);
+	manager.refresh();
+
+	sSpawnFollower.update();
+	if(e.hasComponent<CFollower>()) { std::cerr << "CFollower was created before the refresh\n"; return 1; }
+	manager.refresh();
+
+	if(!e.hasComponent<CFollower>() || !e.hasComponent<COwned>()) { std::cerr << "Deferred components were not created\n"; return 1; }
+	if(&e.getComponent<CFollower>().target != &e.getComponent<CPosition>()) { std::cerr << "CFollower::target does not refer to the entity's CPosition\n"; return 1; }
+	if(e.getComponent<COwned>().value == nullptr || *e.getComponent<COwned>().value != 42) { std::cerr << "COwned::value was not moved in\n"; return 1; }
+
+	std::cout << "ok\n";
+	return 0;
+}